@@ -5,11 +5,10 @@ namespace atcoder {
 
 namespace internal {
 
-std::vector<int> sa_naive(const std::vector<int>& s) {
-    int n = int(s.size());
-    std::vector<int> sa(n);
+template <class Idx, class T> std::vector<Idx> sa_naive(const T* s, Idx n) {
+    std::vector<Idx> sa(n);
     std::iota(sa.begin(), sa.end(), 0);
-    std::sort(sa.begin(), sa.end(), [&](int l, int r) {
+    std::sort(sa.begin(), sa.end(), [&](Idx l, Idx r) {
         if (l == r) return false;
         while (l < n && r < n) {
             if (s[l] != s[r]) return s[l] < s[r];
@@ -21,20 +20,19 @@ std::vector<int> sa_naive(const std::vector<int>& s) {
     return sa;
 }
 
-std::vector<int> sa_doubling(const std::vector<int>& s) {
-    int n = int(s.size());
-    std::vector<int> sa(n), rnk = s, tmp(n);
+template <class Idx, class T> std::vector<Idx> sa_doubling(const T* s, Idx n) {
+    std::vector<Idx> sa(n), rnk(s, s + n), tmp(n);
     std::iota(sa.begin(), sa.end(), 0);
-    for (int k = 1; k < n; k *= 2) {
-        auto cmp = [&](int x, int y) {
+    for (Idx k = 1; k < n; k *= 2) {
+        auto cmp = [&](Idx x, Idx y) {
             if (rnk[x] != rnk[y]) return rnk[x] < rnk[y];
-            int rx = x + k < n ? rnk[x + k] : -1;
-            int ry = y + k < n ? rnk[y + k] : -1;
+            Idx rx = x + k < n ? rnk[x + k] : -1;
+            Idx ry = y + k < n ? rnk[y + k] : -1;
             return rx < ry;
         };
         std::sort(sa.begin(), sa.end(), cmp);
         tmp[sa[0]] = 0;
-        for (int i = 1; i < n; i++) {
+        for (Idx i = 1; i < n; i++) {
             tmp[sa[i]] = tmp[sa[i - 1]] + (cmp(sa[i - 1], sa[i]) ? 1 : 0);
         }
         std::swap(tmp, rnk);
@@ -46,9 +44,11 @@ std::vector<int> sa_doubling(const std::vector<int>& s) {
 // Reference:
 // G. Nong, S. Zhang, and W. H. Chan,
 // Two Efficient Algorithms for Linear Time Suffix Array Construction
-template <int THRESHOLD_NAIVE = 10, int THRESHOLD_DOUBLING = 40>
-std::vector<int> sa_is(const std::vector<int>& s, int upper) {
-    int n = int(s.size());
+// s[0], ..., s[n - 1] must be in [0, upper], the input is read in place (no copy).
+// Idx is the signed index type of the result: int, or long long when n does not fit in an int.
+template <int THRESHOLD_NAIVE = 10, int THRESHOLD_DOUBLING = 40, class Idx, class T>
+std::vector<Idx> sa_is(const T* s, Idx n, Idx upper) {
+    static_assert(std::is_signed<Idx>::value, "-1 is used as a sentinel");
     if (n == 0) return {};
     if (n == 1) return {0};
     if (n == 2) {
@@ -59,33 +59,33 @@ std::vector<int> sa_is(const std::vector<int>& s, int upper) {
         }
     }
     if (n < THRESHOLD_NAIVE) {
-        return sa_naive(s);
+        return sa_naive(s, n);
     }
     if (n < THRESHOLD_DOUBLING) {
-        return sa_doubling(s);
+        return sa_doubling(s, n);
     }
 
-    std::vector<int> sa(n);
+    std::vector<Idx> sa(n);
     std::vector<bool> ls(n);
-    for (int i = n - 2; i >= 0; i--) {
+    for (Idx i = n - 2; i >= 0; i--) {
         ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
     }
-    std::vector<int> sum_l(upper + 1), sum_s(upper + 1);
-    for (int i = 0; i < n; i++) {
+    std::vector<Idx> sum_l(upper + 1), sum_s(upper + 1);
+    for (Idx i = 0; i < n; i++) {
         if (!ls[i]) {
             sum_s[s[i]]++;
         } else {
             sum_l[s[i] + 1]++;
         }
     }
-    for (int i = 0; i <= upper; i++) {
+    for (Idx i = 0; i <= upper; i++) {
         sum_s[i] += sum_l[i];
         if (i < upper) sum_l[i + 1] += sum_s[i];
     }
 
-    auto induce = [&](const std::vector<int>& lms) {
+    auto induce = [&](const std::vector<Idx>& lms) {
         std::fill(sa.begin(), sa.end(), -1);
-        std::vector<int> buf(upper + 1);
+        std::vector<Idx> buf(upper + 1);
         std::copy(sum_s.begin(), sum_s.end(), buf.begin());
         for (auto d : lms) {
             if (d == n) continue;
@@ -93,31 +93,31 @@ std::vector<int> sa_is(const std::vector<int>& s, int upper) {
         }
         std::copy(sum_l.begin(), sum_l.end(), buf.begin());
         sa[buf[s[n - 1]]++] = n - 1;
-        for (int i = 0; i < n; i++) {
-            int v = sa[i];
+        for (Idx i = 0; i < n; i++) {
+            Idx v = sa[i];
             if (v >= 1 && !ls[v - 1]) {
                 sa[buf[s[v - 1]]++] = v - 1;
             }
         }
         std::copy(sum_l.begin(), sum_l.end(), buf.begin());
-        for (int i = n - 1; i >= 0; i--) {
-            int v = sa[i];
+        for (Idx i = n - 1; i >= 0; i--) {
+            Idx v = sa[i];
             if (v >= 1 && ls[v - 1]) {
                 sa[--buf[s[v - 1] + 1]] = v - 1;
             }
         }
     };
 
-    std::vector<int> lms_map(n + 1, -1);
-    int m = 0;
-    for (int i = 1; i < n; i++) {
+    std::vector<Idx> lms_map(n + 1, -1);
+    Idx m = 0;
+    for (Idx i = 1; i < n; i++) {
         if (!ls[i - 1] && ls[i]) {
             lms_map[i] = m++;
         }
     }
-    std::vector<int> lms;
+    std::vector<Idx> lms;
     lms.reserve(m);
-    for (int i = 1; i < n; i++) {
+    for (Idx i = 1; i < n; i++) {
         if (!ls[i - 1] && ls[i]) {
             lms.push_back(i);
         }
@@ -126,18 +126,18 @@ std::vector<int> sa_is(const std::vector<int>& s, int upper) {
     induce(lms);
 
     if (m) {
-        std::vector<int> sorted_lms;
+        std::vector<Idx> sorted_lms;
         sorted_lms.reserve(m);
-        for (int v : sa) {
+        for (Idx v : sa) {
             if (lms_map[v] != -1) sorted_lms.push_back(v);
         }
-        std::vector<int> rec_s(m);
-        int rec_upper = 0;
+        std::vector<Idx> rec_s(m);
+        Idx rec_upper = 0;
         rec_s[lms_map[sorted_lms[0]]] = 0;
-        for (int i = 1; i < m; i++) {
-            int l = sorted_lms[i - 1], r = sorted_lms[i];
-            int end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
-            int end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+        for (Idx i = 1; i < m; i++) {
+            Idx l = sorted_lms[i - 1], r = sorted_lms[i];
+            Idx end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+            Idx end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
             bool same = true;
             if (end_l - l != end_r - r) {
                 same = false;
@@ -155,17 +155,28 @@ std::vector<int> sa_is(const std::vector<int>& s, int upper) {
             rec_s[lms_map[sorted_lms[i]]] = rec_upper;
         }
 
+        // sa and lms_map are not needed during the recursion, release them to lower the peak memory
+        std::vector<Idx>().swap(sa);
+        std::vector<Idx>().swap(lms_map);
         auto rec_sa =
-            sa_is<THRESHOLD_NAIVE, THRESHOLD_DOUBLING>(rec_s, rec_upper);
+            sa_is<THRESHOLD_NAIVE, THRESHOLD_DOUBLING>(rec_s.data(), m, rec_upper);
+        std::vector<Idx>().swap(rec_s);
 
-        for (int i = 0; i < m; i++) {
+        for (Idx i = 0; i < m; i++) {
             sorted_lms[i] = lms[rec_sa[i]];
         }
+        std::vector<Idx>().swap(rec_sa);
+        sa.resize(n);
         induce(sorted_lms);
     }
     return sa;
 }
 
+template <int THRESHOLD_NAIVE = 10, int THRESHOLD_DOUBLING = 40>
+std::vector<int> sa_is(const std::vector<int>& s, int upper) {
+    return sa_is<THRESHOLD_NAIVE, THRESHOLD_DOUBLING>(s.data(), int(s.size()), upper);
+}
+
 }  // namespace internal
 
 std::vector<int> suffix_array(const std::vector<int>& s, int upper) {
@@ -191,34 +202,46 @@ template <class T> std::vector<int> suffix_array(const std::vector<T>& s) {
     return internal::sa_is(s2, now);
 }
 
+// Suffix array of a buffer of characters (char, unsigned char, char16_t, ...) read in place,
+// the characters are compared as unsigned values.
+// Idx is int, or long long for inputs with 2^31 or more characters.
+// Peak memory is about 3 * n * sizeof(Idx) bytes on top of the input, which is not copied.
+template <class Idx = int, class Char>
+std::vector<Idx> suffix_array(std::basic_string_view<Char> s) {
+    using U = std::make_unsigned_t<Char>;
+    static_assert(sizeof(U) <= 2, "use suffix_array(const std::vector<T>&) for larger alphabets");
+    assert(s.size() <= size_t(std::numeric_limits<Idx>::max()));
+    return internal::sa_is((const U*)s.data(), Idx(s.size()),
+                           Idx(std::numeric_limits<U>::max()));
+}
+
+template <class Idx = int>
+std::vector<Idx> suffix_array(const uint8_t* s, size_t n) {
+    return suffix_array<Idx>(std::basic_string_view<uint8_t>(s, n));
+}
+
 std::vector<int> suffix_array(const std::string& s) {
-    int n = int(s.size());
-    std::vector<int> s2(n);
-    for (int i = 0; i < n; i++) {
-        s2[i] = s[i];
-    }
-    return internal::sa_is(s2, 255);
+    return suffix_array<int>(std::string_view(s));
 }
 
 // Reference:
 // T. Kasai, G. Lee, H. Arimura, S. Arikawa, and K. Park,
 // Linear-Time Longest-Common-Prefix Computation in Suffix Arrays and Its
 // Applications
-template <class T>
-std::vector<int> lcp_array(const std::vector<T>& s,
-                           const std::vector<int>& sa) {
-    int n = int(s.size());
+// s[0], ..., s[n - 1] are read in place (no copy).
+template <class Idx, class T>
+std::vector<Idx> lcp_array(const T* s, Idx n, const std::vector<Idx>& sa) {
     assert(n >= 1);
-    std::vector<int> rnk(n);
-    for (int i = 0; i < n; i++) {
+    std::vector<Idx> rnk(n);
+    for (Idx i = 0; i < n; i++) {
         rnk[sa[i]] = i;
     }
-    std::vector<int> lcp(n - 1);
-    int h = 0;
-    for (int i = 0; i < n; i++) {
+    std::vector<Idx> lcp(n - 1);
+    Idx h = 0;
+    for (Idx i = 0; i < n; i++) {
         if (h > 0) h--;
         if (rnk[i] == 0) continue;
-        int j = sa[rnk[i] - 1];
+        Idx j = sa[rnk[i] - 1];
         for (; j + h < n && i + h < n; h++) {
             if (s[j + h] != s[i + h]) break;
         }
@@ -227,13 +250,20 @@ std::vector<int> lcp_array(const std::vector<T>& s,
     return lcp;
 }
 
+template <class T>
+std::vector<int> lcp_array(const std::vector<T>& s,
+                           const std::vector<int>& sa) {
+    return lcp_array(s.data(), int(s.size()), sa);
+}
+
+template <class Idx, class Char>
+std::vector<Idx> lcp_array(std::basic_string_view<Char> s,
+                           const std::vector<Idx>& sa) {
+    return lcp_array(s.data(), Idx(s.size()), sa);
+}
+
 std::vector<int> lcp_array(const std::string& s, const std::vector<int>& sa) {
-    int n = int(s.size());
-    std::vector<int> s2(n);
-    for (int i = 0; i < n; i++) {
-        s2[i] = s[i];
-    }
-    return lcp_array(s2, sa);
+    return lcp_array(std::string_view(s), sa);
 }
 
 // Reference:
@@ -0,0 +1,111 @@
+#ifndef CSR_GRAPH
+#define CSR_GRAPH
+// Compressed sparse row graph: the out-edges of u are adj[start[u]], ..., adj[start[u + 1] - 1]
+// Build in O(N+M) with a counting sort, edges keep their relative order.
+template<typename E>
+struct CSR {
+    vector<int> start;
+    vector<E> adj;
+    CSR() {}
+    CSR(int n, const vector<pair<int, E>>& edges) : start(n + 1), adj(edges.size()) {
+        for (auto& [u, x]:edges) start[u + 1]++;
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        vector<int> ptr(start.begin(), start.end() - 1);
+        for (auto& [u, x]:edges) adj[ptr[u]++] = x;
+    }
+    int size() const { return (int)start.size() - 1; }
+}; // CSR
+#endif // CSR_GRAPH
+
+
+/**
+* Direction-optimizing BFS
+* Switches between top-down steps (expand the frontier queue) and bottom-up steps (every unvisited
+* vertex scans its in-edges for a frontier vertex, stopping at the first hit) on low diameter graphs.
+* Bottom-up frontiers are bitsets, and bottom-up steps are split over threads by 64-vertex words,
+* so each thread only writes its own vertices (compile with -pthread).
+* g_rev is the reversed graph, pass g itself for undirected graphs. G is CSR<int> or any graph with the same
+* start, adj and size(), e.g. a MappedCSR<int> from graph/CSRFile.cc.
+* Time: O(N+M), usually examining far fewer than M edges
+* Source: S. Beamer, K. Asanovic and D. Patterson, Direction-Optimizing Breadth-First Search
+*/
+template<typename G = CSR<int>>
+struct DirectionOptimizingBFS {
+    const G& g;
+    const G& g_rev;
+    int n, threads;
+    int alpha = 14, beta = 24; // switch to bottom-up when m_f > m_u / alpha, back to top-down when n_f < n / beta
+    vector<int> dist; // dist[u] is the number of edges from the source to u, -1 if unreachable
+    DirectionOptimizingBFS(const G& _g, const G& _g_rev, int _threads = 1) : 
+        g(_g), g_rev(_g_rev), n(_g.size()), threads(max(_threads, 1)) {}
+
+    int deg(int u) { return g.start[u + 1] - g.start[u]; }
+    // one bottom-up step, returns the number of new vertices and the sum of their degrees
+    pair<long long, long long> bottom_up(const vector<unsigned long long>& front, vector<unsigned long long>& next, int level) {
+        int words = next.size(), th = words < 64 ? 1 : threads;
+        vector<pair<long long, long long>> found(th);
+        auto work = [&](int t) {
+            for (int w = (long long)words * t / th; w < (long long)words * (t + 1) / th; w++) {
+                unsigned long long bits = 0;
+                for (int u = w * 64; u < min(n, w * 64 + 64); u++) if (dist[u] == -1) {
+                    for (int i = g_rev.start[u]; i < g_rev.start[u + 1]; i++) {
+                        int x = g_rev.adj[i];
+                        if (front[x >> 6] >> (x & 63) & 1) {
+                            dist[u] = level + 1, bits |= 1ULL << (u & 63);
+                            found[t].first++, found[t].second += deg(u);
+                            break;
+                        }
+                    }
+                }
+                next[w] = bits;
+            }
+        };
+        if (th == 1) work(0);
+        else {
+            vector<thread> pool;
+            for (int t = 0; t < th; t++) pool.emplace_back(work, t);
+            for (auto& x:pool) x.join();
+        }
+        pair<long long, long long> res(0, 0);
+        for (auto& [a, b]:found) res.first += a, res.second += b;
+        return res;
+    }
+
+    void run(int s) {
+        dist.assign(n, -1);
+        dist[s] = 0;
+        int words = (n + 63) / 64;
+        vector<int> queue_front(1, s), queue_next;
+        vector<unsigned long long> front, next;
+        long long m_u = g.start[n] - deg(s), m_f = deg(s), n_f = 1; // unexplored edges, frontier edges and vertices
+        bool bottom = false;
+        for (int level = 0; n_f > 0; level++) {
+            if (!bottom && m_f > m_u / alpha) { // convert the queue to a bitset
+                bottom = true;
+                front.assign(words, 0), next.assign(words, 0);
+                for (int u:queue_front) front[u >> 6] |= 1ULL << (u & 63);
+            }
+            else if (bottom && n_f < n / beta) { // convert the bitset to a queue
+                bottom = false;
+                queue_front.clear();
+                for (int w = 0; w < words; w++) 
+                    for (unsigned long long b = front[w]; b; b &= b - 1) queue_front.push_back(w * 64 + __builtin_ctzll(b));
+            }
+            if (bottom) {
+                tie(n_f, m_f) = bottom_up(front, next, level);
+                swap(front, next);
+            }
+            else {
+                queue_next.clear();
+                m_f = 0;
+                for (int u:queue_front) for (int i = g.start[u]; i < g.start[u + 1]; i++) {
+                    int v = g.adj[i];
+                    if (dist[v] == -1) dist[v] = level + 1, queue_next.push_back(v), m_f += deg(v);
+                }
+                swap(queue_front, queue_next);
+                n_f = queue_front.size();
+            }
+            m_u -= m_f;
+        }
+    }
+}; // DirectionOptimizingBFS
\ No newline at end of file
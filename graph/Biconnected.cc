@@ -0,0 +1,113 @@
+#ifndef CSR_GRAPH
+#define CSR_GRAPH
+// Compressed sparse row graph: the out-edges of u are adj[start[u]], ..., adj[start[u + 1] - 1]
+// Build in O(N+M) with a counting sort, edges keep their relative order.
+template<typename E>
+struct CSR {
+    vector<int> start;
+    vector<E> adj;
+    CSR() {}
+    CSR(int n, const vector<pair<int, E>>& edges) : start(n + 1), adj(edges.size()) {
+        for (auto& [u, x]:edges) start[u + 1]++;
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        vector<int> ptr(start.begin(), start.end() - 1);
+        for (auto& [u, x]:edges) adj[ptr[u]++] = x;
+    }
+    int size() const { return (int)start.size() - 1; }
+}; // CSR
+#endif // CSR_GRAPH
+
+
+/**
+* Bridges, articulation points, biconnected components (blocks), the block-cut tree
+* and 2-edge-connected components of an undirected graph with N vertices and M edges.
+* Multi-edges and self loops are allowed. The dfs is iterative so it works on very deep graphs.
+* The graph is an edge list or a CSR<pair<int, int>> like graph (start, adj, size()) of (neighbor, edge id)
+* with every edge stored in both directions under the same id, e.g. a MappedCSR from graph/CSRFile.cc.
+* Time: O(N+M)
+* Sources:
+*  - https://cp-algorithms.com/graph/bridge-searching.html
+*  - https://cp-algorithms.com/graph/cutpoints.html
+*/
+struct Biconnected {
+    int n;
+    vector<int> tin, low;
+    vector<int> bridges;        // ids of the bridge edges
+    vector<char> is_cut;        // is_cut[u] is whether u is an articulation point
+    vector<int> block_start, block_verts; // the vertices of block b are block_verts[block_start[b]...block_start[b + 1])
+    vector<int> two_edge_comp;  // two_edge_comp[u] is the 2-edge-connected component of u
+    int num_two_edge = 0;
+
+    Biconnected(int _n, const vector<pair<int, int>>& edges) : Biconnected(both_directions(_n, edges)) {}
+    template<typename G>
+    Biconnected(const G& g) : n(g.size()), tin(g.size(), -1), low(g.size()), is_cut(g.size(), 0), two_edge_comp(g.size(), -1) {
+        vector<int> it(n), pe(n, -1), stk, block_stk, comp_stk;
+        for (int u = 0; u < n; u++) it[u] = g.start[u];
+        block_start.push_back(0);
+        int timer = 0;
+        for (int r = 0; r < n; r++) if (tin[r] == -1) {
+            int root_children = 0;
+            tin[r] = low[r] = timer++;
+            stk.push_back(r), block_stk.push_back(r), comp_stk.push_back(r);
+            while (stk.size()) {
+                int u = stk.back();
+                if (it[u] < g.start[u + 1]) {
+                    auto [v, id] = g.adj[it[u]++];
+                    if (id == pe[u]) continue;
+                    if (tin[v] == -1) {
+                        pe[v] = id, tin[v] = low[v] = timer++;
+                        stk.push_back(v), block_stk.push_back(v), comp_stk.push_back(v);
+                    }
+                    else low[u] = min(low[u], tin[v]);
+                    continue;
+                }
+                stk.pop_back();
+                if (u == r) break;
+                int p = stk.back();
+                low[p] = min(low[p], low[u]);
+                if (low[u] > tin[p]) { // the edge to the parent is a bridge, u's side is a 2-edge-connected component
+                    bridges.push_back(pe[u]);
+                    pop_component(u, comp_stk);
+                }
+                if (low[u] >= tin[p]) { // p separates u's subtree, which forms a block together with p
+                    if (p == r) root_children++;
+                    else is_cut[p] = 1;
+                    while (block_verts.push_back(block_stk.back()), block_stk.back() != u) block_stk.pop_back();
+                    block_stk.pop_back();
+                    block_verts.push_back(p);
+                    block_start.push_back(block_verts.size());
+                }
+            }
+            is_cut[r] = root_children > 1;
+            if (root_children == 0) block_verts.push_back(r), block_start.push_back(block_verts.size()); // isolated vertex
+            block_stk.pop_back();
+            pop_component(r, comp_stk);
+        }
+    }
+    static CSR<pair<int, int>> both_directions(int n, const vector<pair<int, int>>& edges) {
+        vector<pair<int, pair<int, int>>> e;
+        e.reserve(2 * edges.size());
+        for (int i = 0; i < (int)edges.size(); i++) {
+            e.push_back({edges[i].first, {edges[i].second, i}});
+            e.push_back({edges[i].second, {edges[i].first, i}});
+        }
+        return CSR<pair<int, int>>(n, e);
+    }
+    void pop_component(int u, vector<int>& comp_stk) {
+        while (two_edge_comp[comp_stk.back()] = num_two_edge, comp_stk.back() != u) comp_stk.pop_back();
+        comp_stk.pop_back();
+        num_two_edge++;
+    }
+    int num_blocks() { return block_start.size() - 1; }
+
+    // vertices [0, n) are the original vertices and n + b is the node of block b
+    // each block is adjacent to the vertices it contains, so it is a forest
+    vector<vector<int>> block_cut_tree() {
+        vector<vector<int>> tr(n + num_blocks());
+        for (int b = 0; b < num_blocks(); b++) for (int i = block_start[b]; i < block_start[b + 1]; i++) {
+            tr[n + b].push_back(block_verts[i]);
+            tr[block_verts[i]].push_back(n + b);
+        }
+        return tr;
+    }
+}; // Biconnected
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef CSR_GRAPH
+#define CSR_GRAPH
+// Compressed sparse row graph: the out-edges of u are adj[start[u]], ..., adj[start[u + 1] - 1]
+// Build in O(N+M) with a counting sort, edges keep their relative order.
+template<typename E>
+struct CSR {
+    vector<int> start;
+    vector<E> adj;
+    CSR() {}
+    CSR(int n, const vector<pair<int, E>>& edges) : start(n + 1), adj(edges.size()) {
+        for (auto& [u, x]:edges) start[u + 1]++;
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        vector<int> ptr(start.begin(), start.end() - 1);
+        for (auto& [u, x]:edges) adj[ptr[u]++] = x;
+    }
+    int size() const { return (int)start.size() - 1; }
+}; // CSR
+#endif // CSR_GRAPH
+
+
+/**
+* Binary on-disk format for CSR graphs, loaded with mmap so nothing is parsed or copied at startup.
+* Layout (native endianness): CSRHeader, start[n + 1] (int32), padding to 8 bytes, adj[m] (E).
+* E must be plain data without pointers, e.g. int or pair<int, W>.
+* MappedCSR exposes start/adj/size() with the same indexing as CSR, and the CSR algorithms take it directly
+* (ShortestPath, DirectionOptimizingBFS, DominatorTree, Biconnected, Blossom, DAGReachability), so the mapped
+* arrays are used in place. to_adj_list() copies into the vector<vector<int>> trees used by LCA/HLD.
+* open checks the header and start against the file, the entries of adj are not checked.
+* Time: write O(N+M), open O(N) (adj pages are read lazily by the OS)
+*/
+struct CSRHeader {
+    char magic[8];
+    uint32_t version, edge_size;
+    int64_t n, m;
+};
+
+inline size_t csr_adj_offset(int64_t n) { return (sizeof(CSRHeader) + (n + 1) * sizeof(int) + 7) / 8 * 8; }
+
+// returns whether the file was written
+template<typename E>
+bool write_csr(const string& path, const CSR<E>& g) {
+    if (g.start.empty()) return false;
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    CSRHeader h{{'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'}, 1, sizeof(E), g.size(), (int64_t)g.adj.size()};
+    size_t pad = csr_adj_offset(h.n) - sizeof(CSRHeader) - (h.n + 1) * sizeof(int);
+    const char zeros[8] = {};
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+        && fwrite(g.start.data(), sizeof(int), g.start.size(), f) == g.start.size()
+        && fwrite(zeros, 1, pad, f) == pad
+        && (g.adj.empty() || fwrite(g.adj.data(), sizeof(E), g.adj.size(), f) == g.adj.size());
+    return fclose(f) == 0 && ok;
+}
+
+template<typename E>
+struct MappedCSR {
+    const int* start = nullptr;
+    const E* adj = nullptr;
+    int n = 0;
+    int64_t m = 0;
+    void* base = MAP_FAILED;
+    size_t len = 0;
+
+    MappedCSR() {}
+    MappedCSR(const MappedCSR&) = delete;
+    MappedCSR& operator=(const MappedCSR&) = delete;
+    ~MappedCSR() { close(); }
+
+    // returns false if the file cannot be mapped or is not a CSR file with edges of type E
+    bool open(const string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(CSRHeader)) {
+            len = st.st_size;
+            base = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (base == MAP_FAILED) return false;
+        const CSRHeader* h = (const CSRHeader*)base;
+        bool ok = memcmp(h->magic, "CSRGRAPH", 8) == 0 && h->version == 1 && h->edge_size == sizeof(E)
+            && 0 <= h->n && h->n <= INT_MAX && 0 <= h->m && csr_adj_offset(h->n) <= len
+            && (uint64_t)h->m <= (len - csr_adj_offset(h->n)) / sizeof(E); // no overflow in m * sizeof(E)
+        const int* s = (const int*)((const char*)base + sizeof(CSRHeader));
+        if (ok) ok = s[0] == 0 && s[h->n] == h->m;
+        for (int64_t u = 0; ok && u < h->n; u++) ok = s[u] <= s[u + 1];
+        if (!ok) {
+            close();
+            return false;
+        }
+        n = h->n, m = h->m, start = s;
+        adj = (const E*)((const char*)base + csr_adj_offset(n));
+        madvise(base, len, MADV_WILLNEED);
+        return true;
+    }
+    void close() {
+        if (base != MAP_FAILED) munmap(base, len);
+        base = MAP_FAILED, start = nullptr, adj = nullptr, n = 0, m = 0, len = 0;
+    }
+    int size() const { return n; }
+
+    vector<vector<int>> to_adj_list() const { // for E = int
+        vector<vector<int>> res(n);
+        for (int u = 0; u < n; u++) res[u].assign(adj + start[u], adj + start[u + 1]);
+        return res;
+    }
+}; // MappedCSR
\ No newline at end of file
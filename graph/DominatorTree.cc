@@ -0,0 +1,85 @@
+#ifndef CSR_GRAPH
+#define CSR_GRAPH
+// Compressed sparse row graph: the out-edges of u are adj[start[u]], ..., adj[start[u + 1] - 1]
+// Build in O(N+M) with a counting sort, edges keep their relative order.
+template<typename E>
+struct CSR {
+    vector<int> start;
+    vector<E> adj;
+    CSR() {}
+    CSR(int n, const vector<pair<int, E>>& edges) : start(n + 1), adj(edges.size()) {
+        for (auto& [u, x]:edges) start[u + 1]++;
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        vector<int> ptr(start.begin(), start.end() - 1);
+        for (auto& [u, x]:edges) adj[ptr[u]++] = x;
+    }
+    int size() const { return (int)start.size() - 1; }
+}; // CSR
+#endif // CSR_GRAPH
+
+
+/**
+* Dominator Tree (Lengauer-Tarjan)
+* idom[v] is the immediate dominator of v: the last vertex other than v on every path from the root to v.
+* idom[root] = root and idom[v] = -1 if v is unreachable. The dfs and the path compression are iterative.
+* The graph is an edge list or a CSR<int> like graph (start, adj, size()), e.g. a MappedCSR<int> from graph/CSRFile.cc.
+* Time: O((N+M)*log(N))
+* Sources:
+*  - T. Lengauer and R. Tarjan, A Fast Algorithm for Finding Dominators in a Flowgraph
+*  - https://tanujkhattar.wordpress.com/2016/01/11/dominator-tree-of-a-directed-graph/
+*/
+struct DominatorTree {
+    int n;
+    vector<int> idom;
+    vector<int> ord, vs, par, semi, label, anc; // everything but ord is indexed by dfs number
+    vector<int> stk;
+
+    DominatorTree(int _n, const vector<pair<int, int>>& edges, int root) : DominatorTree(CSR<int>(_n, edges), root) {}
+    template<typename G>
+    DominatorTree(const G& g, int root) : n(g.size()), idom(g.size(), -1), ord(g.size(), -1) {
+        vector<pair<int, int>> rev;
+        rev.reserve(g.start[n]);
+        for (int u = 0; u < n; u++) for (int j = g.start[u]; j < g.start[u + 1]; j++) rev.emplace_back(g.adj[j], u);
+        CSR<int> pred(n, rev);
+        vector<int> it(n);
+        for (int u = 0; u < n; u++) it[u] = g.start[u];
+        ord[root] = 0, vs.push_back(root), par.push_back(-1), stk.push_back(root);
+        while (stk.size()) { // dfs numbering
+            int u = stk.back();
+            if (it[u] == g.start[u + 1]) { stk.pop_back(); continue; }
+            int v = g.adj[it[u]++];
+            if (ord[v] == -1) ord[v] = vs.size(), vs.push_back(v), par.push_back(ord[u]), stk.push_back(v);
+        }
+        int k = vs.size();
+        semi.resize(k), label.resize(k), anc.assign(k, -1);
+        iota(semi.begin(), semi.end(), 0), iota(label.begin(), label.end(), 0);
+        vector<int> dom(k), bucket_start(k + 1, -1), bucket_next(k); // bucket[s] is a linked list of the vertices with semi s
+        for (int i = k - 1; i > 0; i--) {
+            int w = vs[i];
+            for (int j = pred.start[w]; j < pred.start[w + 1]; j++) 
+                if (ord[pred.adj[j]] != -1) semi[i] = min(semi[i], semi[eval(ord[pred.adj[j]])]);
+            bucket_next[i] = bucket_start[semi[i]], bucket_start[semi[i]] = i;
+            int p = par[i];
+            anc[i] = p;
+            for (int v = bucket_start[p]; v != -1; v = bucket_next[v]) {
+                int u = eval(v);
+                dom[v] = semi[u] < semi[v] ? u : p;
+            }
+            bucket_start[p] = -1;
+        }
+        for (int i = 1; i < k; i++) if (dom[i] != semi[i]) dom[i] = dom[dom[i]];
+        for (int i = 0; i < k; i++) idom[vs[i]] = vs[dom[i]];
+    }
+    // the vertex with minimum semi on the path from v up to (excluding) the root of its tree in the forest
+    int eval(int v) {
+        if (anc[v] == -1) return v;
+        for (int x = v; anc[anc[x]] != -1; x = anc[x]) stk.push_back(x);
+        while (stk.size()) { // compress from the top down
+            int x = stk.back();
+            stk.pop_back();
+            if (semi[label[anc[x]]] < semi[label[x]]) label[x] = label[anc[x]];
+            anc[x] = anc[anc[x]];
+        }
+        return label[v];
+    }
+}; // DominatorTree
\ No newline at end of file
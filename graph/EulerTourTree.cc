@@ -0,0 +1,138 @@
+/**
+* Euler Tour Tree
+* Maintains a dynamic forest under link/cut/reroot with subtree and component aggregates.
+* Each tree is stored as its euler tour (vertex nodes and one node per directed edge) in an
+* implicit key treap with parent pointers. Nodes live in a single arena and are referred to by index, -1 is null.
+* Only vertex nodes carry values. op must be commutative since rerooting rotates the tour.
+* Time: expected O(log(N)) per operation
+* Sources:
+*  - https://en.wikipedia.org/wiki/Euler_tour_technique#Euler_tour_trees
+*  - https://cp-algorithms.com/data_structures/treap.html (implicit treap)
+*/
+template<typename S, S (*op)(S, S), S (*e)()>
+struct EulerTourTree {
+    struct Node {
+        int l = -1, r = -1, p = -1; // the children and the parent in the treap
+        int size = 1;               // the number of nodes in the treap subtree
+        unsigned pri;               // the heap priority
+        S val, sum;                 // the value of the node and the aggregate of its treap subtree
+    };
+    vector<Node> t;          // the arena, nodes [0, n) are the vertices
+    vector<int> free_nodes;  // edge nodes that can be reused
+    unordered_map<long long, int> edge_node; // edge_node[u * n + v] is the node of the directed edge (u, v)
+    mt19937 rng;
+    int n;
+
+    EulerTourTree(int _n) : EulerTourTree(vector<S>(_n, e())) {}
+    EulerTourTree(const vector<S>& vals) : t(vals.size()), rng(chrono::steady_clock::now().time_since_epoch().count()), n(vals.size()) {
+        for (int i = 0; i < n; i++) t[i].pri = rng(), t[i].val = t[i].sum = vals[i];
+    }
+
+    int size(int x) { return x == -1 ? 0 : t[x].size; }
+    S sum(int x) { return x == -1 ? e() : t[x].sum; }
+    void pull(int x) {
+        t[x].size = size(t[x].l) + 1 + size(t[x].r);
+        t[x].sum = op(op(sum(t[x].l), t[x].val), sum(t[x].r));
+    }
+    int new_node() {
+        int x;
+        if (free_nodes.size()) x = free_nodes.back(), free_nodes.pop_back(), t[x] = Node();
+        else x = t.size(), t.emplace_back();
+        t[x].pri = rng(), t[x].val = t[x].sum = e();
+        return x;
+    }
+    int merge(int a, int b) {
+        if (a == -1 || b == -1) return a == -1 ? b : a;
+        if (t[a].pri > t[b].pri) {
+            t[a].r = merge(t[a].r, b);
+            t[t[a].r].p = a;
+            pull(a);
+            return a;
+        }
+        t[b].l = merge(a, t[b].l);
+        t[t[b].l].p = b;
+        pull(b);
+        return b;
+    }
+    // splits x into the first k nodes and the rest, the returned roots have no parent
+    pair<int, int> split(int x, int k) {
+        if (x == -1) return {-1, -1};
+        t[x].p = -1;
+        if (size(t[x].l) >= k) {
+            auto [a, b] = split(t[x].l, k);
+            t[x].l = b;
+            if (b != -1) t[b].p = x;
+            pull(x);
+            return {a, x};
+        }
+        auto [a, b] = split(t[x].r, k - size(t[x].l) - 1);
+        t[x].r = a;
+        if (a != -1) t[a].p = x;
+        pull(x);
+        return {x, b};
+    }
+    int root(int x) { while (t[x].p != -1) x = t[x].p; return x; }
+    int index(int x) { // the position of x in its euler tour
+        int res = size(t[x].l);
+        for (; t[x].p != -1; x = t[x].p) if (t[t[x].p].r == x) res += size(t[t[x].p].l) + 1;
+        return res;
+    }
+
+    bool connected(int u, int v) { return root(u) == root(v); }
+    void reroot(int v) { // rotates the tour of v's tree so that it begins at v
+        auto [a, b] = split(root(v), index(v));
+        merge(b, a);
+    }
+    // adds the edge (u, v), returns false if u and v were already connected
+    bool link(int u, int v) {
+        if (connected(u, v)) return false;
+        reroot(u), reroot(v);
+        int uv = new_node(), vu = new_node();
+        edge_node[(long long)u * n + v] = uv, edge_node[(long long)v * n + u] = vu;
+        merge(merge(merge(root(u), uv), root(v)), vu);
+        return true;
+    }
+    // removes the edge (u, v), returns false if there was no such edge
+    bool cut(int u, int v) {
+        auto it1 = edge_node.find((long long)u * n + v);
+        if (it1 == edge_node.end()) return false;
+        auto it2 = edge_node.find((long long)v * n + u);
+        int uv = it1->second, vu = it2->second;
+        edge_node.erase(it1), edge_node.erase(it2);
+        int i = index(uv), j = index(vu);
+        if (i > j) swap(i, j);
+        auto [ab, c] = split(root(uv), j + 1);
+        auto [a, b] = split(ab, i);
+        merge(a, c); // the tour without the subtree hanging below the edge
+        auto [first, rest] = split(b, 1);
+        int last = split(rest, size(rest) - 1).second; // the tour of the subtree is now its own tree
+        free_nodes.push_back(first), free_nodes.push_back(last);
+        return true;
+    }
+
+    S get(int v) { return t[v].val; }
+    void set(int v, const S& x) {
+        t[v].val = x;
+        for (; v != -1; v = t[v].p) pull(v);
+    }
+    S component(int v) { return t[root(v)].sum; } // the aggregate of the tree containing v
+    // the aggregate of the subtree of v when the tree is rooted at p, where (v, p) is an edge
+    S subtree(int v, int p) {
+        auto pv = edge_node.find((long long)p * n + v), vp = edge_node.find((long long)v * n + p);
+        assert(pv != edge_node.end() && vp != edge_node.end()); // (v, p) must be an edge, the lookup never inserts
+        reroot(p);
+        int i = index(pv->second), j = index(vp->second);
+        auto [ab, c] = split(root(v), j);
+        auto [a, b] = split(ab, i + 1);
+        S res = sum(b);
+        merge(merge(a, b), c);
+        return res;
+    }
+}; // EulerTourTree
+
+struct S_ETT { // segment
+};
+S_ETT op_ett(S_ETT l, S_ETT r) { // the combine operation for two segments, must be commutative
+}
+S_ETT e_ett() { return S_ETT(); } // the identity segment
+using ETT = EulerTourTree<S_ETT, op_ett, e_ett>;
\ No newline at end of file
@@ -0,0 +1,302 @@
+#ifndef CSR_GRAPH
+#define CSR_GRAPH
+// Compressed sparse row graph: the out-edges of u are adj[start[u]], ..., adj[start[u + 1] - 1]
+// Build in O(N+M) with a counting sort, edges keep their relative order.
+template<typename E>
+struct CSR {
+    vector<int> start;
+    vector<E> adj;
+    CSR() {}
+    CSR(int n, const vector<pair<int, E>>& edges) : start(n + 1), adj(edges.size()) {
+        for (auto& [u, x]:edges) start[u + 1]++;
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        vector<int> ptr(start.begin(), start.end() - 1);
+        for (auto& [u, x]:edges) adj[ptr[u]++] = x;
+    }
+    int size() const { return (int)start.size() - 1; }
+}; // CSR
+#endif // CSR_GRAPH
+
+
+/**
+* Maximum cardinality matching in a general (not necessarily bipartite) graph with Edmonds' blossom algorithm.
+* A greedy matching is built first, then one alternating bfs per free vertex. Blossoms are contracted
+* with a DSU over their bases and only the touched vertices are reset between searches.
+* mate[u] is the vertex matched with u, -1 if u is free.
+* G is CSR<int> or any graph with the same start, adj and size() (e.g. a MappedCSR<int> from graph/CSRFile.cc)
+* that stores every edge in both directions; it is used in place and must outlive the Blossom.
+* Time: O(N*M*alpha(N)) worst case, much faster on random graphs
+* Sources:
+*  - https://cp-algorithms.com/graph/edmonds_blossom.html
+*  - J. Edmonds, Paths, Trees, and Flowers
+*/
+template<typename G = CSR<int>>
+struct Blossom {
+    int n;
+    G own;      // the graph built from an edge list
+    const G& g; // own or the caller's graph
+    vector<int> mate, label, par, base, vis, touched, q;
+    int stamp = 0;
+    Blossom(int _n, const vector<pair<int, int>>& edges) : n(_n), own(both_directions(_n, edges)), g(own) { init(); }
+    Blossom(const G& _g) : n(_g.size()), g(_g) { init(); }
+    Blossom(const Blossom&) = delete;
+    static G both_directions(int n, const vector<pair<int, int>>& edges) {
+        vector<pair<int, int>> e;
+        e.reserve(2 * edges.size());
+        for (auto [u, v]:edges) if (u != v) e.emplace_back(u, v), e.emplace_back(v, u);
+        return G(n, e);
+    }
+    void init() {
+        mate.assign(n, -1), label.assign(n, -1), par.assign(n, -1), base.resize(n), vis.assign(n, 0);
+        iota(base.begin(), base.end(), 0);
+    }
+    int find(int x) { // the base of the blossom containing x
+        while (base[x] != x) x = base[x] = base[base[x]];
+        return x;
+    }
+    int lca(int a, int b) { // walks up from both outer bases alternately until a base is seen twice
+        stamp++;
+        while (true) {
+            if (a != -1) {
+                if (vis[a] == stamp) return a;
+                vis[a] = stamp;
+                a = mate[a] == -1 ? -1 : find(par[mate[a]]);
+            }
+            swap(a, b);
+        }
+    }
+    void contract(int v, int u, int b) { // contracts the path from v to the base b, entering v from u
+        while (find(v) != b) {
+            par[v] = u, u = mate[v];
+            if (label[u] == 1) label[u] = 0, q.push_back(u);
+            base[find(v)] = b, base[find(u)] = b;
+            v = par[u];
+        }
+    }
+    void augment(int v, int u) { // u is free and adjacent to the outer vertex v
+        while (v != -1) {
+            int next = mate[v];
+            mate[u] = v, mate[v] = u;
+            u = next;
+            v = u == -1 ? -1 : par[u];
+        }
+    }
+    bool search(int root) {
+        for (int x:touched) label[x] = -1, par[x] = -1, base[x] = x;
+        touched.assign(1, root), q.assign(1, root);
+        label[root] = 0;
+        for (int i = 0; i < (int)q.size(); i++) {
+            int v = q[i];
+            for (int j = g.start[v]; j < g.start[v + 1]; j++) {
+                int u = g.adj[j];
+                if (label[u] == -1) {
+                    if (mate[u] == -1) { augment(v, u); return true; }
+                    label[u] = 1, par[u] = v, label[mate[u]] = 0;
+                    touched.push_back(u), touched.push_back(mate[u]), q.push_back(mate[u]);
+                }
+                else if (label[u] == 0 && find(u) != find(v)) {
+                    int b = lca(find(v), find(u));
+                    contract(v, u, b), contract(u, v, b);
+                }
+            }
+        }
+        return false;
+    }
+    int max_matching() {
+        int res = 0;
+        for (int u = 0; u < n; u++) if (mate[u] == -1) // greedy start
+            for (int j = g.start[u]; j < g.start[u + 1]; j++) if (mate[g.adj[j]] == -1 && g.adj[j] != u) {
+                mate[u] = g.adj[j], mate[g.adj[j]] = u, res++;
+                break;
+            }
+        for (int u = 0; u < n; u++) if (mate[u] == -1 && search(u)) res++;
+        return res;
+    }
+}; // Blossom
+
+/**
+* Maximum weight matching in a general graph (weighted blossom with dual variables, Gabow's O(N^3) variant).
+* The graph is stored as a dense matrix so this is meant for N up to a few thousand.
+* Weights must be positive, missing edges have weight 0. mate[u] is the vertex matched with u, -1 if u is free.
+* Time: O(N^3)
+* Sources:
+*  - H. Gabow, An Efficient Implementation of Edmonds' Algorithm for Maximum Matching on Graphs
+*  - https://uoj.ac/problem/81 (widely used implementation)
+*/
+struct WeightedBlossom {
+    struct Edge { int u, v; long long w; };
+    int n, n_x; // vertices are [1, n], blossoms are (n, n_x]
+    vector<vector<Edge>> g;
+    vector<vector<int>> flower_from, flower;
+    vector<long long> lab;
+    vector<int> match, slack, st, pa, S, vis, mate;
+    deque<int> q;
+    int stamp = 0;
+    WeightedBlossom(int _n) : n(_n), g(2 * _n + 1, vector<Edge>(2 * _n + 1)), flower_from(2 * _n + 1, vector<int>(_n + 1)),
+        flower(2 * _n + 1), lab(2 * _n + 1), match(2 * _n + 1), slack(2 * _n + 1), st(2 * _n + 1), pa(2 * _n + 1), S(2 * _n + 1), vis(2 * _n + 1) {
+        for (int u = 1; u <= 2 * n; u++) for (int v = 1; v <= 2 * n; v++) g[u][v] = Edge{u, v, 0};
+    }
+    void add_edge(int u, int v, long long w) { // 0-indexed, keeps the heaviest of parallel edges
+        u++, v++;
+        if (u != v && w > g[u][v].w) g[u][v].w = g[v][u].w = w;
+    }
+
+    long long dist(const Edge& e) { return lab[e.u] + lab[e.v] - e.w * 2; }
+    void update_slack(int u, int x) { if (!slack[x] || dist(g[u][x]) < dist(g[slack[x]][x])) slack[x] = u; }
+    void set_slack(int x) {
+        slack[x] = 0;
+        for (int u = 1; u <= n; u++) if (g[u][x].w > 0 && st[u] != x && S[st[u]] == 0) update_slack(u, x);
+    }
+    void q_push(int x) {
+        if (x <= n) q.push_back(x);
+        else for (int y:flower[x]) q_push(y);
+    }
+    void set_st(int x, int b) {
+        st[x] = b;
+        if (x > n) for (int y:flower[x]) set_st(y, b);
+    }
+    int get_pr(int b, int xr) {
+        int pr = find(flower[b].begin(), flower[b].end(), xr) - flower[b].begin();
+        if (pr % 2 == 1) {
+            reverse(flower[b].begin() + 1, flower[b].end());
+            return (int)flower[b].size() - pr;
+        }
+        return pr;
+    }
+    void set_match(int u, int v) {
+        match[u] = g[u][v].v;
+        if (u <= n) return;
+        Edge e = g[u][v];
+        int xr = flower_from[u][e.u], pr = get_pr(u, xr);
+        for (int i = 0; i < pr; i++) set_match(flower[u][i], flower[u][i ^ 1]);
+        set_match(xr, v);
+        rotate(flower[u].begin(), flower[u].begin() + pr, flower[u].end());
+    }
+    void augment(int u, int v) {
+        while (true) {
+            int xnv = st[match[u]];
+            set_match(u, v);
+            if (!xnv) return;
+            set_match(xnv, st[pa[xnv]]);
+            u = st[pa[xnv]], v = xnv;
+        }
+    }
+    int get_lca(int u, int v) {
+        for (++stamp; u || v; swap(u, v)) {
+            if (u == 0) continue;
+            if (vis[u] == stamp) return u;
+            vis[u] = stamp;
+            u = st[match[u]];
+            if (u) u = st[pa[u]];
+        }
+        return 0;
+    }
+    void add_blossom(int u, int lca, int v) {
+        int b = n + 1;
+        while (b <= n_x && st[b]) b++;
+        if (b > n_x) n_x++;
+        lab[b] = 0, S[b] = 0;
+        match[b] = match[lca];
+        flower[b].assign(1, lca);
+        for (int x = u, y; x != lca; x = st[pa[y]]) flower[b].push_back(x), flower[b].push_back(y = st[match[x]]), q_push(y);
+        reverse(flower[b].begin() + 1, flower[b].end());
+        for (int x = v, y; x != lca; x = st[pa[y]]) flower[b].push_back(x), flower[b].push_back(y = st[match[x]]), q_push(y);
+        set_st(b, b);
+        for (int x = 1; x <= n_x; x++) g[b][x].w = g[x][b].w = 0;
+        for (int x = 1; x <= n; x++) flower_from[b][x] = 0;
+        for (int xs:flower[b]) {
+            for (int x = 1; x <= n_x; x++) 
+                if (g[b][x].w == 0 || dist(g[xs][x]) < dist(g[b][x])) g[b][x] = g[xs][x], g[x][b] = g[x][xs];
+            for (int x = 1; x <= n; x++) if (flower_from[xs][x]) flower_from[b][x] = xs;
+        }
+        set_slack(b);
+    }
+    void expand_blossom(int b) {
+        for (int x:flower[b]) set_st(x, x);
+        int xr = flower_from[b][g[b][pa[b]].u], pr = get_pr(b, xr);
+        for (int i = 0; i < pr; i += 2) {
+            int xs = flower[b][i], xns = flower[b][i + 1];
+            pa[xs] = g[xns][xs].u;
+            S[xs] = 1, S[xns] = 0;
+            slack[xs] = 0, set_slack(xns);
+            q_push(xns);
+        }
+        S[xr] = 1, pa[xr] = pa[b];
+        for (int i = pr + 1; i < (int)flower[b].size(); i++) S[flower[b][i]] = -1, set_slack(flower[b][i]);
+        st[b] = 0;
+    }
+    bool on_found_edge(const Edge& e) {
+        int u = st[e.u], v = st[e.v];
+        if (S[v] == -1) {
+            pa[v] = e.u, S[v] = 1;
+            int nu = st[match[v]];
+            slack[v] = slack[nu] = 0;
+            S[nu] = 0, q_push(nu);
+        }
+        else if (S[v] == 0) {
+            int lca = get_lca(u, v);
+            if (!lca) return augment(u, v), augment(v, u), true;
+            add_blossom(u, lca, v);
+        }
+        return false;
+    }
+    bool matching() { // one augmentation, false if the matching cannot gain weight
+        fill(S.begin() + 1, S.begin() + n_x + 1, -1);
+        fill(slack.begin() + 1, slack.begin() + n_x + 1, 0);
+        q.clear();
+        for (int x = 1; x <= n_x; x++) if (st[x] == x && !match[x]) pa[x] = 0, S[x] = 0, q_push(x);
+        if (q.empty()) return false;
+        while (true) {
+            while (q.size()) {
+                int u = q.front();
+                q.pop_front();
+                if (S[st[u]] == 1) continue;
+                for (int v = 1; v <= n; v++) if (g[u][v].w > 0 && st[u] != st[v]) {
+                    if (dist(g[u][v]) == 0) { if (on_found_edge(g[u][v])) return true; }
+                    else update_slack(u, st[v]);
+                }
+            }
+            long long d = LLONG_MAX;
+            for (int b = n + 1; b <= n_x; b++) if (st[b] == b && S[b] == 1) d = min(d, lab[b] / 2);
+            for (int x = 1; x <= n_x; x++) if (st[x] == x && slack[x]) {
+                if (S[x] == -1) d = min(d, dist(g[slack[x]][x]));
+                else if (S[x] == 0) d = min(d, dist(g[slack[x]][x]) / 2);
+            }
+            for (int u = 1; u <= n; u++) if (S[st[u]] == 0 && lab[u] <= d) return false; // a free vertex's dual hits 0
+            for (int u = 1; u <= n; u++) {
+                if (S[st[u]] == 0) lab[u] -= d;
+                else if (S[st[u]] == 1) lab[u] += d;
+            }
+            for (int b = n + 1; b <= n_x; b++) if (st[b] == b) {
+                if (S[st[b]] == 0) lab[b] += d * 2;
+                else if (S[st[b]] == 1) lab[b] -= d * 2;
+            }
+            q.clear();
+            for (int x = 1; x <= n_x; x++) 
+                if (st[x] == x && slack[x] && st[slack[x]] != x && dist(g[slack[x]][x]) == 0 && on_found_edge(g[slack[x]][x])) return true;
+            for (int b = n + 1; b <= n_x; b++) if (st[b] == b && S[b] == 1 && lab[b] == 0) expand_blossom(b);
+        }
+        return false;
+    }
+    // returns (total weight, number of matched pairs) and fills mate
+    pair<long long, int> max_weight_matching() {
+        fill(match.begin(), match.end(), 0);
+        n_x = n;
+        for (int u = 0; u <= 2 * n; u++) st[u] = u, flower[u].clear();
+        long long w_max = 0;
+        for (int u = 1; u <= n; u++) for (int v = 1; v <= n; v++) {
+            flower_from[u][v] = u == v ? u : 0;
+            w_max = max(w_max, g[u][v].w);
+        }
+        for (int u = 1; u <= n; u++) lab[u] = w_max;
+        int pairs = 0;
+        while (matching()) pairs++;
+        long long res = 0;
+        mate.assign(n, -1);
+        for (int u = 1; u <= n; u++) if (match[u]) {
+            mate[u - 1] = match[u] - 1;
+            if (match[u] < u) res += g[u][match[u]].w;
+        }
+        return {res, pairs};
+    }
+}; // WeightedBlossom
\ No newline at end of file
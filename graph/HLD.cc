@@ -196,7 +196,10 @@ struct HLD_LCA {
     }
 }; //HLD_LCA 
 
-template<bool VALS_EDGES, typename S, S (*op)(S, S), S (*e)()>
+// LEAN = true skips building HLD_LCA (2N euler tour + 2N*log(2N) sparse table) and instead
+// finds the lca by climbing heavy paths, using O(N) memory overall.
+// Trade-off: lca in O(log(N)) instead of O(1), which is dominated by the O(log(N)^2) path query anyway.
+template<bool VALS_EDGES, typename S, S (*op)(S, S), S (*e)(), bool LEAN = false>
 struct HeavyLightDecomposition {
     vector<int> par, heavy, head, pos;
     atcoder::segtree<S, op, e> st;
@@ -204,7 +207,7 @@ struct HeavyLightDecomposition {
     int root;
     HeavyLightDecomposition(int _root, const vector<vector<int>>& tr) :
         par(tr.size(), _root), heavy(tr.size(), -1), head(tr.size()), 
-        pos(tr.size()), st(tr.size()), lca(_root, tr), root(_root) {
+        pos(tr.size()), st(tr.size()), lca(LEAN ? HLD_LCA() : HLD_LCA(_root, tr)), root(_root) {
             assign_heavy(root, tr);
             int idx = 0;
             decompose(root, root, idx, tr);
@@ -212,14 +215,14 @@ struct HeavyLightDecomposition {
         }
     HeavyLightDecomposition(int _root, const vector<vector<int>>& tr, const vector<S>& vals) :
         par(tr.size(), _root), heavy(tr.size(), -1), head(tr.size()),
-        pos(tr.size()), lca(_root, tr), root(_root) {
+        pos(tr.size()), lca(LEAN ? HLD_LCA() : HLD_LCA(_root, tr)), root(_root) {
             assign_heavy(root, tr);
             int idx = 0;
             decompose(root, root, idx, tr);
             assert(idx == (int)tr.size());
             vector<S> ordered_vals(vals.size());
             for (int i = 0; i < (int)vals.size(); i++) ordered_vals[pos[i]] = vals[i];
-            st = atcoder::lazy_segtree<S, op, e>(ordered_vals);
+            st = atcoder::segtree<S, op, e>(ordered_vals);
         }
     int assign_heavy(int u, const vector<vector<int>>& tr) {
         int size = 1, max_x_size = 0;
@@ -244,9 +247,15 @@ struct HeavyLightDecomposition {
         for (; head[u] != head[ancestor]; u = par[head[u]]) res = op(res, st.prod(pos[head[u]], pos[u] + 1));
         return op(res, st.prod(pos[ancestor] + dont_get_ancestor, pos[u] + 1));
     }
+    // O(log(N)): the head of a deeper heavy path always has a larger pos, so climb from it
+    int climb_lca(int u, int v) {
+        for (; head[u] != head[v]; u = par[head[u]]) if (pos[head[u]] < pos[head[v]]) swap(u, v);
+        return pos[u] < pos[v] ? u : v;
+    }
+    int get_lca(int u, int v) { return LEAN ? climb_lca(u, v) : lca.get_lca(u, v); }
     S get(int u, int v) {
         if (u == v) return st.prod(pos[u], pos[u] + 1);
-        int top = lca.get_lca(u, v);
+        int top = get_lca(u, v);
         if (u == top) return get_vertical(v, top, VALS_EDGES);
         if (v == top) return get_vertical(u, top, VALS_EDGES);
         return op(get_vertical(u, top, VALS_EDGES), get_vertical(v, top, 1));
@@ -258,6 +267,6 @@ struct S_HLD { // segment
 S_HLD op_hld(S_HLD l, S_HLD r) { // the combine operation for two segments
 }
 S_HLD e_hld() { return S_HLD(); } // the identity segment
-template<bool VALS_EDGES> using HLD = 
-    HeavyLightDecomposition<VALS_EDGES, S_HLD, op_hld, e_hld>;
+template<bool VALS_EDGES, bool LEAN = false> using HLD = 
+    HeavyLightDecomposition<VALS_EDGES, S_HLD, op_hld, e_hld, LEAN>;
 	
@@ -56,3 +56,31 @@ struct LCA {
                 max(first_euler[u], first_euler[v]) + 1)]; 
     }
 }; // LCA
+
+
+// Virtual (auxiliary) tree of a set of k vertices: the vertices and the pairwise lcas of adjacent
+// vertices in euler order, where each vertex's parent is its nearest ancestor in the set.
+// The buffers are reused between queries so nothing is allocated once they have grown.
+// Time: O(k*log(k)) per query
+struct VirtualTree {
+    LCA& lca;
+    vector<int> vs;  // the vertices of the virtual tree in euler order, vs[0] is its root
+    vector<int> par; // par[i] is the index in vs of the parent of vs[i], -1 for the root
+    VirtualTree(LCA& _lca) : lca(_lca) {}
+    void build(const vector<int>& marked) {
+        vs.assign(marked.begin(), marked.end());
+        auto by_euler = [&](int u, int v) { return lca.first_euler[u] < lca.first_euler[v]; };
+        sort(vs.begin(), vs.end(), by_euler);
+        for (int i = 0, k = marked.size(); i + 1 < k; i++) vs.push_back(lca.get_lca(vs[i], vs[i + 1]));
+        sort(vs.begin(), vs.end(), by_euler);
+        vs.erase(unique(vs.begin(), vs.end()), vs.end());
+        par.assign(vs.size(), -1);
+        // the parent of vs[i] is lca(vs[i - 1], vs[i]), which is an ancestor of vs[i - 1] in the virtual tree
+        // each vertex is walked past at most once since it then leaves the rightmost path, so this is O(k)
+        for (int i = 1; i < (int)vs.size(); i++) {
+            int p = lca.get_lca(vs[i - 1], vs[i]), j = i - 1;
+            while (vs[j] != p) j = par[j];
+            par[i] = j;
+        }
+    }
+}; // VirtualTree
\ No newline at end of file
@@ -0,0 +1,145 @@
+/**
+* Link Cut Tree
+* Maintains a dynamic forest under link/cut with path aggregates and lazy path updates.
+* Nodes live in a single arena (vector) and are referred to by index, -1 is null.
+* op does not need to be commutative, the reversed aggregate is kept for evert.
+* Time: amortized O(log(N)) per operation
+* Sources:
+*  - https://codeforces.com/blog/entry/18462 (splaying, see data/splay_tree.cc)
+*  - https://en.wikipedia.org/wiki/Link/cut_tree
+*/
+template<typename S, S (*op)(S, S), S (*e)(), typename F, S (*mapping)(F, S), F (*composition)(F, F), F (*id)()>
+struct LinkCutTree {
+    struct Node {
+        int ch[2] = {-1, -1}; // the children in the splay tree of the preferred path
+        int p = -1;           // the splay parent, or the path parent if this is the root of its splay tree
+        bool rev = false;     // whether the subtrees of the children must be reversed
+        S val, sum, rsum;     // the value of the node, the aggregate of its splay subtree and the reversed aggregate
+        F lz;                 // the lazy update to push to the children
+        Node() : val(e()), sum(e()), rsum(e()), lz(id()) {}
+    };
+    vector<Node> t; // the arena
+    vector<int> stk;
+
+    LinkCutTree(int _n) : t(_n) {}
+    LinkCutTree(const vector<S>& vals) : t(vals.size()) {
+        for (int i = 0; i < (int)vals.size(); i++) t[i].val = t[i].sum = t[i].rsum = vals[i];
+    }
+
+    bool is_root(int x) { // whether x is the root of its splay tree
+        int p = t[x].p;
+        return p == -1 || (t[p].ch[0] != x && t[p].ch[1] != x);
+    }
+    void pull(int x) {
+        int l = t[x].ch[0], r = t[x].ch[1];
+        t[x].sum = op(op(l == -1 ? e() : t[l].sum, t[x].val), r == -1 ? e() : t[r].sum);
+        t[x].rsum = op(op(r == -1 ? e() : t[r].rsum, t[x].val), l == -1 ? e() : t[l].rsum);
+    }
+    void apply(int x, const F& f) {
+        if (x == -1) return;
+        t[x].val = mapping(f, t[x].val);
+        t[x].sum = mapping(f, t[x].sum);
+        t[x].rsum = mapping(f, t[x].rsum);
+        t[x].lz = composition(f, t[x].lz);
+    }
+    void toggle(int x) {
+        if (x == -1) return;
+        swap(t[x].ch[0], t[x].ch[1]);
+        swap(t[x].sum, t[x].rsum);
+        t[x].rev ^= 1;
+    }
+    void push(int x) {
+        if (t[x].rev) toggle(t[x].ch[0]), toggle(t[x].ch[1]), t[x].rev = false;
+        apply(t[x].ch[0], t[x].lz), apply(t[x].ch[1], t[x].lz);
+        t[x].lz = id();
+    }
+
+    void rotate(int x) { // rotates x above its parent
+        int p = t[x].p, g = t[p].p;
+        int d = t[p].ch[1] == x;
+        int b = t[x].ch[d ^ 1];
+        if (!is_root(p)) t[g].ch[t[g].ch[1] == p] = x;
+        t[x].p = g;
+        t[x].ch[d ^ 1] = p, t[p].p = x;
+        t[p].ch[d] = b;
+        if (b != -1) t[b].p = p;
+        pull(p), pull(x);
+    }
+    void splay(int x) {
+        stk.push_back(x);
+        for (int y = x; !is_root(y); y = t[y].p) stk.push_back(t[y].p);
+        while (stk.size()) push(stk.back()), stk.pop_back(); // push lazies from the top down
+        while (!is_root(x)) {
+            int p = t[x].p;
+            if (!is_root(p)) rotate((t[p].ch[1] == x) == (t[t[p].p].ch[1] == p) ? p : x); // zig-zig or zig-zag
+            rotate(x);
+        }
+    }
+    // makes the path from the root to x preferred, x becomes the root of its splay tree
+    // returns the last path parent that was jumped to (used for lca)
+    int access(int x) {
+        int last = -1;
+        for (int y = x; y != -1; last = y, y = t[y].p) {
+            splay(y);
+            t[y].ch[1] = last;
+            pull(y);
+        }
+        splay(x);
+        return last;
+    }
+
+    void evert(int u) { access(u), toggle(u); } // makes u the root of its tree
+    int find_root(int u) {
+        access(u);
+        for (push(u); t[u].ch[0] != -1; push(u)) u = t[u].ch[0];
+        splay(u);
+        return u;
+    }
+    bool connected(int u, int v) { return u == v || find_root(u) == find_root(v); }
+    // adds the edge (u, v), returns false if u and v were already connected
+    bool link(int u, int v) {
+        if (connected(u, v)) return false;
+        evert(u);
+        t[u].p = v;
+        return true;
+    }
+    // removes the edge (u, v), returns false if there was no such edge
+    bool cut(int u, int v) {
+        evert(u), access(v);
+        if (t[v].ch[0] != u || t[u].ch[1] != -1) return false;
+        t[v].ch[0] = t[u].p = -1;
+        pull(v);
+        return true;
+    }
+    // lca of u and v when the tree is rooted at r, -1 if they are not connected
+    int lca(int u, int v, int r) {
+        if (!connected(u, v)) return -1;
+        evert(r), access(u);
+        return access(v);
+    }
+
+    S get(int u) { access(u); return t[u].val; }
+    void set(int u, const S& x) { access(u), t[u].val = x, pull(u); }
+    S prod(int u, int v) { // the aggregate of the path from u to v (in that order)
+        evert(u), access(v);
+        return t[v].sum;
+    }
+    void apply(int u, int v, const F& f) { // applies f to every vertex on the path from u to v
+        evert(u), access(v);
+        apply(v, f);
+    }
+}; // LinkCutTree
+
+struct S_LCT { // segment
+};
+struct F_LCT { // lazy update
+};
+S_LCT op_lct(S_LCT l, S_LCT r) { // the combine operation for two segments
+}
+S_LCT mapping_lct(F_LCT l, S_LCT r) { // the update operation for a segment
+}
+F_LCT composition_lct(F_LCT l, F_LCT r) { // composition of two lazy updates (l is applied after r)
+}
+S_LCT e_lct() { return S_LCT(); } // the identity segment
+F_LCT id_lct() { return F_LCT(); } // the identity update
+using LCT = LinkCutTree<S_LCT, op_lct, e_lct, F_LCT, mapping_lct, composition_lct, id_lct>;
\ No newline at end of file
@@ -0,0 +1,147 @@
+/**
+* Minimum spanning forest of an undirected graph with N vertices and M edges with integer weights.
+*  - kruskal: LSD radix sort on the weights (bytes that are equal for every edge are skipped). Time: O(M*bytes + M*alpha(N))
+*  - filter_kruskal: partitions around a random pivot weight and drops the heavy edges that are already
+*    inside a component before sorting them. Time: O(M + N*log(N)*log(M/N)) expected
+*  - boruvka: each round every component picks its lightest outgoing edge in parallel and the picked edges are
+*    hooked into a lock-free DSU. Time: O(M*log(N)/threads) (compile with -pthread)
+* Weights must be non-negative. Ties are broken by edge index so every method returns the same forest.
+* Requires DSU from graph/DSU.cc for kruskal and filter_kruskal.
+* Sources:
+*  - https://cp-algorithms.com/graph/mst_kruskal_with_dsu.html
+*  - V. Osipov, P. Sanders and J. Singler, The Filter-Kruskal Minimum Spanning Tree Algorithm
+*  - https://en.wikipedia.org/wiki/Bor%C5%AFvka%27s_algorithm
+*/
+template<typename W>
+struct MST {
+    struct Edge { int u, v; W w; };
+
+    // stable sort of the edges by weight
+    static void radix_sort(vector<Edge>& e) {
+        using U = make_unsigned_t<W>;
+        vector<Edge> tmp(e.size());
+        U all_or = 0, all_and = ~U(0);
+        for (auto& x:e) all_or |= U(x.w), all_and &= U(x.w);
+        for (int shift = 0; shift < (int)sizeof(U) * 8; shift += 8) {
+            if (((all_or ^ all_and) >> shift & 255) == 0) continue; // this byte is the same for every edge
+            array<int, 257> cnt{};
+            for (auto& x:e) cnt[(U(x.w) >> shift & 255) + 1]++;
+            for (int i = 0; i < 256; i++) cnt[i + 1] += cnt[i];
+            for (auto& x:e) tmp[cnt[U(x.w) >> shift & 255]++] = x;
+            e.swap(tmp);
+        }
+    }
+
+    // edges must be sorted by weight, adds the edges that join two components to tree
+    static W kruskal_sorted(DSU& dsu, const vector<Edge>& e, vector<Edge>& tree) {
+        W res = 0;
+        for (auto& x:e) if (dsu.unite(x.u, x.v)) res += x.w, tree.push_back(x);
+        return res;
+    }
+
+    static W kruskal(int n, vector<Edge> e, vector<Edge>& tree) {
+        radix_sort(e);
+        DSU dsu(n);
+        return kruskal_sorted(dsu, e, tree);
+    }
+
+    static W filter_kruskal(DSU& dsu, vector<Edge>& e, vector<Edge>& tree, mt19937& rng) {
+        if (e.size() < 4096) {
+            radix_sort(e);
+            return kruskal_sorted(dsu, e, tree);
+        }
+        W pivot = e[rng() % e.size()].w;
+        auto mid = stable_partition(e.begin(), e.end(), [&](const Edge& x) { return x.w <= pivot; });
+        vector<Edge> heavy(mid, e.end());
+        e.erase(mid, e.end());
+        if (heavy.empty()) { // every weight is at most the pivot, split off the edges equal to it instead
+            auto eq = stable_partition(e.begin(), e.end(), [&](const Edge& x) { return x.w < pivot; });
+            heavy.assign(eq, e.end());
+            e.erase(eq, e.end());
+            if (e.empty()) return kruskal_sorted(dsu, heavy, tree); // all weights are equal
+        }
+        W res = filter_kruskal(dsu, e, tree, rng);
+        vector<Edge>().swap(e);
+        heavy.erase(remove_if(heavy.begin(), heavy.end(), [&](const Edge& x) { return dsu.find(x.u) == dsu.find(x.v); }), heavy.end());
+        return res + filter_kruskal(dsu, heavy, tree, rng);
+    }
+
+    static W filter_kruskal(int n, vector<Edge> e, vector<Edge>& tree) {
+        DSU dsu(n);
+        mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
+        return filter_kruskal(dsu, e, tree, rng);
+    }
+
+    // lock-free DSU: roots are hooked below smaller roots with a compare and swap
+    struct ConcurrentDSU {
+        vector<atomic<int>> par;
+        ConcurrentDSU(int n) : par(n) { for (int i = 0; i < n; i++) par[i].store(i, memory_order_relaxed); }
+        int find(int x) { // path halving
+            while (true) {
+                int p = par[x].load(memory_order_relaxed), gp = par[p].load(memory_order_relaxed);
+                if (p == gp) return p;
+                par[x].compare_exchange_weak(p, gp, memory_order_relaxed);
+                x = gp;
+            }
+        }
+        bool unite(int x, int y) {
+            while (true) {
+                x = find(x), y = find(y);
+                if (x == y) return false;
+                if (x < y) swap(x, y);
+                int expected = x;
+                if (par[x].compare_exchange_strong(expected, y)) return true;
+            }
+        }
+    }; // ConcurrentDSU
+
+    // runs f(i, t) for i in [0, n) split into contiguous blocks over the threads, t is the thread index
+    template<typename Fn>
+    static void parallel_for(int n, int threads, Fn f) {
+        if (threads <= 1 || n < 1024) {
+            for (int i = 0; i < n; i++) f(i, 0);
+            return;
+        }
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back([&, t] {
+            for (int i = (long long)n * t / threads; i < (long long)n * (t + 1) / threads; i++) f(i, t);
+        });
+        for (auto& th:pool) th.join();
+    }
+
+    static W boruvka(int n, const vector<Edge>& edges, vector<Edge>& tree, int threads = thread::hardware_concurrency()) {
+        threads = max(threads, 1);
+        ConcurrentDSU dsu(n);
+        vector<atomic<int>> best(n); // best[r] is the index of the lightest edge leaving the component with root r
+        vector<int> alive(edges.size()), picked; // the indices of the edges between different components
+        iota(alive.begin(), alive.end(), 0);
+        auto lighter = [&](int i, int j) { return edges[i].w != edges[j].w ? edges[i].w < edges[j].w : i < j; };
+        auto propose = [&](int r, int i) {
+            int cur = best[r].load(memory_order_relaxed);
+            while ((cur == -1 || lighter(i, cur)) && !best[r].compare_exchange_weak(cur, i, memory_order_relaxed));
+        };
+        W res = 0;
+        while (alive.size()) {
+            for (auto& b:best) b.store(-1, memory_order_relaxed);
+            parallel_for(alive.size(), threads, [&](int k, int) {
+                int i = alive[k];
+                propose(dsu.find(edges[i].u), i), propose(dsu.find(edges[i].v), i);
+            });
+            picked.clear();
+            for (int r = 0; r < n; r++) if (best[r].load(memory_order_relaxed) != -1) picked.push_back(best[r]);
+            vector<char> joined(picked.size(), 0);
+            parallel_for(picked.size(), threads, [&](int k, int) {
+                joined[k] = dsu.unite(edges[picked[k]].u, edges[picked[k]].v);
+            });
+            for (int k = 0; k < (int)picked.size(); k++) if (joined[k]) res += edges[picked[k]].w, tree.push_back(edges[picked[k]]);
+            vector<char> keep(alive.size());
+            parallel_for(alive.size(), threads, [&](int k, int) {
+                keep[k] = dsu.find(edges[alive[k]].u) != dsu.find(edges[alive[k]].v);
+            });
+            int sz = 0;
+            for (int k = 0; k < (int)alive.size(); k++) if (keep[k]) alive[sz++] = alive[k];
+            alive.resize(sz);
+        }
+        return res;
+    }
+}; // MST
\ No newline at end of file
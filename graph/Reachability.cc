@@ -0,0 +1,98 @@
+#ifndef CSR_GRAPH
+#define CSR_GRAPH
+// Compressed sparse row graph: the out-edges of u are adj[start[u]], ..., adj[start[u + 1] - 1]
+// Build in O(N+M) with a counting sort, edges keep their relative order.
+template<typename E>
+struct CSR {
+    vector<int> start;
+    vector<E> adj;
+    CSR() {}
+    CSR(int n, const vector<pair<int, E>>& edges) : start(n + 1), adj(edges.size()) {
+        for (auto& [u, x]:edges) start[u + 1]++;
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        vector<int> ptr(start.begin(), start.end() - 1);
+        for (auto& [u, x]:edges) adj[ptr[u]++] = x;
+    }
+    int size() const { return (int)start.size() - 1; }
+}; // CSR
+#endif // CSR_GRAPH
+
+
+/**
+* Offline reachability queries on a DAG ("can u reach v").
+* Queries are grouped by source, and batch_words * 64 sources at a time get one bit each. Their bits are
+* pushed along the edges in topological order, so a batch costs one pass over the graph.
+* Knobs: memory_bytes bounds the bitsets (N * batch_words * 8 bytes), batch_words is the most that fits, at least 1
+* and at most enough for all the distinct sources. A larger budget means fewer passes.
+* G is CSR<int> or any graph with the same start, adj and size() (e.g. a MappedCSR<int> from graph/CSRFile.cc),
+* which is used in place and must outlive the DAGReachability.
+* Time: O((N+M) * (number of distinct sources) / 64 + Q*log(Q))
+*/
+template<typename G = CSR<int>>
+struct DAGReachability {
+    int n;
+    G own;      // the graph built from an edge list
+    const G& g; // own or the caller's graph
+    vector<int> topo; // a topological order of the vertices
+    DAGReachability(int _n, const vector<pair<int, int>>& edges) : n(_n), own(_n, edges), g(own) { init(); }
+    DAGReachability(const G& _g) : n(_g.size()), g(_g) { init(); }
+    DAGReachability(const DAGReachability&) = delete;
+    void init() {
+        vector<int> indeg(n);
+        for (int j = 0; j < g.start[n]; j++) indeg[g.adj[j]]++;
+        for (int u = 0; u < n; u++) if (!indeg[u]) topo.push_back(u);
+        for (int i = 0; i < (int)topo.size(); i++) 
+            for (int j = g.start[topo[i]]; j < g.start[topo[i] + 1]; j++) if (!--indeg[g.adj[j]]) topo.push_back(g.adj[j]);
+        assert((int)topo.size() == n); // the graph must be acyclic
+    }
+
+    vector<char> query(const vector<pair<int, int>>& queries, size_t memory_bytes = 64 << 20) {
+        vector<char> res(queries.size());
+        vector<int> qs(queries.size());
+        iota(qs.begin(), qs.end(), 0);
+        sort(qs.begin(), qs.end(), [&](int a, int b) { return queries[a].first < queries[b].first; });
+        long long distinct = 0;
+        for (int i = 0; i < (int)qs.size(); i++) distinct += i == 0 || queries[qs[i]].first != queries[qs[i - 1]].first;
+        int batch_words = max(1LL, min((distinct + 63) >> 6, (long long)(memory_bytes / 8 / max(n, 1))));
+        vector<unsigned long long> bits((size_t)n * batch_words);
+        for (int lo = 0; lo < (int)qs.size();) {
+            fill(bits.begin(), bits.end(), 0);
+            int hi = lo, sources = 0; // the queries in [lo, hi) use at most batch_words * 64 distinct sources
+            for (; hi < (int)qs.size(); hi++) {
+                int s = queries[qs[hi]].first;
+                if (hi == lo || s != queries[qs[hi - 1]].first) {
+                    if (sources == batch_words * 64) break;
+                    bits[(size_t)s * batch_words + (sources >> 6)] |= 1ULL << (sources & 63);
+                    sources++;
+                }
+            }
+            int words = (sources + 63) >> 6;
+            for (int u:topo) {
+                const unsigned long long* bu = &bits[(size_t)u * batch_words];
+                for (int j = g.start[u]; j < g.start[u + 1]; j++) {
+                    unsigned long long* bv = &bits[(size_t)g.adj[j] * batch_words];
+                    for (int w = 0; w < words; w++) bv[w] |= bu[w];
+                }
+            }
+            for (int i = lo, bit = -1; i < hi; i++) {
+                auto [s, t] = queries[qs[i]];
+                if (i == lo || s != queries[qs[i - 1]].first) bit++;
+                res[qs[i]] = bits[(size_t)t * batch_words + (bit >> 6)] >> (bit & 63) & 1;
+            }
+            lo = hi;
+        }
+        return res;
+    }
+}; // DAGReachability
+
+// Condensation of a directed graph given its sccs (e.g. from atcoder::scc_graph::scc(), which are in topological order).
+// Sets id[u] to the scc of u and returns the deduplicated edges between sccs.
+vector<pair<int, int>> condense(int n, const vector<pair<int, int>>& edges, const vector<vector<int>>& groups, vector<int>& id) {
+    id.assign(n, -1);
+    for (int i = 0; i < (int)groups.size(); i++) for (int u:groups[i]) id[u] = i;
+    vector<pair<int, int>> res;
+    for (auto [u, v]:edges) if (id[u] != id[v]) res.emplace_back(id[u], id[v]);
+    sort(res.begin(), res.end());
+    res.erase(unique(res.begin(), res.end()), res.end());
+    return res;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+* Rerooting: tree dp for every root at once.
+* dp(v) = finalize(merge over the neighbors c of v (as children) of add_edge(dp of c's side, c, v), v)
+* Two iterative passes over a flat bfs order (bottom-up, then top-down with prefix/suffix merges in a
+* shared scratch buffer), no recursion and no per-vertex vectors.
+* Time: O(N)
+*/
+template<typename S, S (*merge)(S, S), S (*e)(), S (*add_edge)(S, int, int), S (*finalize)(S, int)>
+struct Rerooting {
+    int n;
+    vector<int> adj_start, adj, order, par;
+    vector<S> down, up, ans; // down[v]: dp of v's subtree when rooted at 0, up[v]: dp of par[v]'s side without v
+    Rerooting(const vector<vector<int>>& tr) : n(tr.size()), adj_start(n + 1), order(n), par(n, -1), down(n), up(n), ans(n) {
+        for (int u = 0; u < n; u++) adj_start[u + 1] = adj_start[u] + tr[u].size();
+        adj.reserve(adj_start[n]);
+        for (int u = 0; u < n; u++) adj.insert(adj.end(), tr[u].begin(), tr[u].end());
+        if (!n) return;
+        for (int i = 0, sz = 1; i < sz; i++) { // bfs order from 0
+            int u = order[i];
+            for (int j = adj_start[u]; j < adj_start[u + 1]; j++) if (adj[j] != par[u]) par[adj[j]] = u, order[sz++] = adj[j];
+        }
+        for (int i = n - 1; i >= 0; i--) {
+            int u = order[i];
+            S acc = e();
+            for (int j = adj_start[u]; j < adj_start[u + 1]; j++) if (adj[j] != par[u]) acc = merge(acc, add_edge(down[adj[j]], adj[j], u));
+            down[u] = finalize(acc, u);
+        }
+        vector<S> pre, suf; // pre[k] merges the first k contributions, suf[k] the ones from k on
+        for (int u:order) {
+            int deg = adj_start[u + 1] - adj_start[u];
+            pre.resize(deg + 1), suf.resize(deg + 1);
+            pre[0] = e(), suf[deg] = e();
+            auto contribution = [&](int k) {
+                int c = adj[adj_start[u] + k];
+                return c == par[u] ? add_edge(up[u], c, u) : add_edge(down[c], c, u);
+            };
+            for (int k = 0; k < deg; k++) pre[k + 1] = merge(pre[k], contribution(k));
+            for (int k = deg - 1; k >= 0; k--) suf[k] = merge(contribution(k), suf[k + 1]);
+            ans[u] = finalize(pre[deg], u);
+            for (int k = 0; k < deg; k++) {
+                int c = adj[adj_start[u] + k];
+                if (c != par[u]) up[c] = finalize(merge(pre[k], suf[k + 1]), u);
+            }
+        }
+    }
+}; // Rerooting
+
+struct S_RR { // dp value
+};
+S_RR merge_rr(S_RR l, S_RR r) { // merges the contributions of two children
+}
+S_RR e_rr() { return S_RR(); } // the identity contribution
+S_RR add_edge_rr(S_RR x, int child, int parent) { // turns the dp of child's side into its contribution to parent
+}
+S_RR finalize_rr(S_RR x, int v) { // turns the merged contributions of v's children into the dp of v
+}
+using RR = Rerooting<S_RR, merge_rr, e_rr, add_edge_rr, finalize_rr>;
\ No newline at end of file
@@ -7,10 +7,11 @@
 struct SCC {
     vector<vector<int>> G; // the directed input graph
     vector<vector<int>> G_rev; // the reversed graph
-    vector<vector<int>> G_scc; // the DAG of sccs
+    vector<vector<int>> G_scc; // the DAG of sccs, G_scc[i] holds each j with an edge j -> i once (j < i)
     vector<vector<int>> sccs; // the sccs
     vector<int> order; // for topological sort
     vector<int> which_scc; // which_scc[i] is the number of the scc that vertex i belongs to
+    vector<int> last_added; // last_added[j] is the last scc that j was added to as a neighbor, to skip duplicate edges
 
     SCC(int _n) : G(_n), G_rev(_n), which_scc(_n) {}
 
@@ -39,7 +40,8 @@ struct SCC {
             if (which_scc[neighbor] == -1) {
                 dfs(neighbor, current_scc, neighbors);
             }
-            else if (which_scc[neighbor] != which_scc[current_vertex]) {
+            else if (which_scc[neighbor] != which_scc[current_vertex] && last_added[which_scc[neighbor]] != which_scc[current_vertex]) {
+                last_added[which_scc[neighbor]] = which_scc[current_vertex];
                 neighbors.push_back(which_scc[neighbor]);
             }
         }
@@ -48,7 +50,7 @@ struct SCC {
     // builds the DAG of sccs as well as labels each vertex with the scc it belongs to
     // builds G_scc and sccs in topological order of sccs
     void get_sccs() {
-        order.clear();
+        order.clear(), sccs.clear(), G_scc.clear(), last_added.clear();
         fill(which_scc.begin(), which_scc.end(), -1);
         for (int i = 0; i < (int) G.size(); i++) {
             order_vertices(i);
@@ -59,10 +61,46 @@ struct SCC {
             if (which_scc[order[i]] == -1) {
                 vector<int> current_scc;
                 vector<int> neighbors;
+                last_added.push_back(-1);
                 dfs(order[i], current_scc, neighbors);
                 sccs.push_back(current_scc);
                 G_scc.push_back(neighbors);
             }
         }
     }
+
+    // returns the transitive reduction of G_scc (in the same format): the edges j -> i such that 
+    // i cannot be reached from j through another path
+    // the reachability bitsets only cover block_bits target sccs at a time, so memory is O(N*block_bits/64) words
+    // Time: O((N+M)*N/64) where N and M are the number of sccs and DAG edges
+    vector<vector<int>> transitive_reduction(int block_bits = 1 << 12) {
+        int n = sccs.size(), words = (block_bits + 63) / 64;
+        vector<int> out_start(n + 1), out;
+        for (int i = 0; i < n; i++) for (int j:G_scc[i]) out_start[j + 1]++;
+        for (int i = 0; i < n; i++) out_start[i + 1] += out_start[i];
+        out.resize(out_start[n]);
+        vector<int> ptr(out_start.begin(), out_start.end() - 1);
+        for (int i = 0; i < n; i++) for (int j:G_scc[i]) out[ptr[j]++] = i; // successors in increasing topological order
+        vector<char> redundant(out.size(), 0);
+        vector<unsigned long long> reach((size_t)n * words);
+        for (int lo = 0; lo < n; lo += words * 64) {
+            fill(reach.begin(), reach.end(), 0);
+            for (int u = min(n, lo + words * 64) - 1; u >= 0; u--) { // only sccs before the block can reach it
+                unsigned long long* ru = &reach[(size_t)u * words];
+                // a successor can only be reached through successors that come before it in topological order
+                for (int k = out_start[u]; k < out_start[u + 1]; k++) {
+                    int v = out[k], b = v - lo;
+                    if (b >= 0 && b < words * 64) {
+                        if (ru[b >> 6] >> (b & 63) & 1) redundant[k] = 1;
+                        else ru[b >> 6] |= 1ULL << (b & 63);
+                    }
+                    const unsigned long long* rv = &reach[(size_t)v * words];
+                    for (int w = 0; w < words; w++) ru[w] |= rv[w];
+                }
+            }
+        }
+        vector<vector<int>> res(n);
+        for (int u = 0; u < n; u++) for (int k = out_start[u]; k < out_start[u + 1]; k++) if (!redundant[k]) res[out[k]].push_back(u);
+        return res;
+    }
 }; // SCC
\ No newline at end of file
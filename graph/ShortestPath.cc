@@ -0,0 +1,208 @@
+#ifndef CSR_GRAPH
+#define CSR_GRAPH
+// Compressed sparse row graph: the out-edges of u are adj[start[u]], ..., adj[start[u + 1] - 1]
+// Build in O(N+M) with a counting sort, edges keep their relative order.
+template<typename E>
+struct CSR {
+    vector<int> start;
+    vector<E> adj;
+    CSR() {}
+    CSR(int n, const vector<pair<int, E>>& edges) : start(n + 1), adj(edges.size()) {
+        for (auto& [u, x]:edges) start[u + 1]++;
+        for (int i = 0; i < n; i++) start[i + 1] += start[i];
+        vector<int> ptr(start.begin(), start.end() - 1);
+        for (auto& [u, x]:edges) adj[ptr[u]++] = x;
+    }
+    int size() const { return (int)start.size() - 1; }
+}; // CSR
+#endif // CSR_GRAPH
+
+/**
+* Single source shortest paths over a weighted CSR graph (edges are (to, weight)).
+*  - dijkstra: non-negative weights, the heap is a template parameter. Time: O((N+M)*log(N)) with BinaryHeap
+*  - bfs01: weights in {0, 1}. Time: O(N+M)
+*  - spfa: any weights, detects negative cycles reachable from the source. Time: O(N*M) worst case
+*  - delta_stepping: non-negative weights, relaxes each bucket with several threads (compile with -pthread)
+* Unreachable vertices have distance INF.
+* The graph can be any type with start, adj and size() laid out like CSR, e.g. a MappedCSR from graph/CSRFile.cc.
+* Sources:
+*  - https://cp-algorithms.com/graph/dijkstra_sparse.html
+*  - https://cp-algorithms.com/graph/01_bfs.html
+*  - https://cp-algorithms.com/graph/bellman_ford.html
+*  - U. Meyer and P. Sanders, Delta-stepping: a parallelizable shortest path algorithm
+*/
+template<typename W>
+struct ShortestPath {
+    using Graph = CSR<pair<int, W>>;
+    static constexpr W INF = numeric_limits<W>::max() / 2;
+
+    // lazy deletion binary heap
+    struct BinaryHeap {
+        priority_queue<pair<W, int>, vector<pair<W, int>>, greater<pair<W, int>>> pq;
+        void push(W d, int u) { pq.emplace(d, u); }
+        pair<W, int> pop() { auto res = pq.top(); pq.pop(); return res; }
+        bool empty() { return pq.empty(); }
+    }; // BinaryHeap
+
+    // monotone radix heap, W must be an unsigned-convertible integer type
+    struct RadixHeap {
+        vector<pair<W, int>> buckets[65];
+        W last = 0;
+        int sz = 0;
+        static int bucket(W x) { return x == 0 ? 0 : 64 - __builtin_clzll((unsigned long long)x); }
+        void push(W d, int u) { sz++, buckets[bucket(d ^ last)].emplace_back(d, u); }
+        pair<W, int> pop() {
+            if (buckets[0].empty()) {
+                int i = 1;
+                while (buckets[i].empty()) i++;
+                last = min_element(buckets[i].begin(), buckets[i].end())->first;
+                for (auto& x:buckets[i]) buckets[bucket(x.first ^ last)].push_back(x);
+                buckets[i].clear();
+            }
+            sz--;
+            auto res = buckets[0].back();
+            buckets[0].pop_back();
+            return res;
+        }
+        bool empty() { return sz == 0; }
+    }; // RadixHeap
+
+    template<typename Heap = BinaryHeap, typename G = Graph>
+    static vector<W> dijkstra(const G& g, int s) {
+        vector<W> dist(g.size(), INF);
+        Heap heap;
+        dist[s] = 0;
+        heap.push(0, s);
+        while (!heap.empty()) {
+            auto [d, u] = heap.pop();
+            if (d != dist[u]) continue;
+            for (int i = g.start[u]; i < g.start[u + 1]; i++) {
+                auto [v, w] = g.adj[i];
+                if (d + w < dist[v]) dist[v] = d + w, heap.push(dist[v], v);
+            }
+        }
+        return dist;
+    }
+
+    template<typename G = Graph>
+    static vector<W> bfs01(const G& g, int s) {
+        vector<W> dist(g.size(), INF);
+        deque<int> q;
+        dist[s] = 0;
+        q.push_back(s);
+        while (q.size()) {
+            int u = q.front();
+            q.pop_front();
+            for (int i = g.start[u]; i < g.start[u + 1]; i++) {
+                auto [v, w] = g.adj[i];
+                if (dist[u] + w < dist[v]) {
+                    dist[v] = dist[u] + w;
+                    if (w == 0) q.push_front(v);
+                    else q.push_back(v);
+                }
+            }
+        }
+        return dist;
+    }
+
+    // returns false if a negative cycle is reachable from s, in which case dist is not meaningful
+    template<typename G = Graph>
+    static bool spfa(const G& g, int s, vector<W>& dist) {
+        int n = g.size();
+        dist.assign(n, INF);
+        vector<int> len(n, 0); // the number of edges on the current shortest path
+        vector<char> in_queue(n, 0);
+        queue<int> q;
+        dist[s] = 0;
+        q.push(s), in_queue[s] = 1;
+        while (q.size()) {
+            int u = q.front();
+            q.pop(), in_queue[u] = 0;
+            for (int i = g.start[u]; i < g.start[u + 1]; i++) {
+                auto [v, w] = g.adj[i];
+                if (dist[u] + w < dist[v]) {
+                    dist[v] = dist[u] + w, len[v] = len[u] + 1;
+                    if (len[v] >= n) return false; // a shortest path cannot have n edges
+                    if (!in_queue[v]) q.push(v), in_queue[v] = 1;
+                }
+            }
+        }
+        return true;
+    }
+
+    // runs f(i, t) for i in [0, n) split into contiguous blocks over the threads, t is the thread index
+    template<typename Fn>
+    static void parallel_for(int n, int threads, Fn f) {
+        if (threads <= 1 || n < 1024) {
+            for (int i = 0; i < n; i++) f(i, 0);
+            return;
+        }
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back([&, t] {
+            for (int i = (long long)n * t / threads; i < (long long)n * (t + 1) / threads; i++) f(i, t);
+        });
+        for (auto& th:pool) th.join();
+    }
+
+    // bucket i holds the vertices with distance in [i*delta, (i+1)*delta)
+    // edges lighter than delta are relaxed until the bucket is settled, heavy edges once afterwards
+    template<typename G = Graph>
+    static vector<W> delta_stepping(const G& g, int s, W delta, int threads = thread::hardware_concurrency()) {
+        int n = g.size();
+        threads = max(threads, 1);
+        vector<atomic<W>> dist(n);
+        for (auto& d:dist) d.store(INF, memory_order_relaxed);
+        vector<vector<int>> buckets(1, vector<int>(1, s)), updated(threads);
+        dist[s].store(0);
+        auto relax = [&](int v, W nd, int t) {
+            W cur = dist[v].load(memory_order_relaxed);
+            while (nd < cur) if (dist[v].compare_exchange_weak(cur, nd, memory_order_relaxed)) {
+                updated[t].push_back(v);
+                break;
+            }
+        };
+        auto flush = [&]() { // moves the updated vertices into their buckets
+            for (auto& upd:updated) {
+                for (int v:upd) {
+                    size_t b = dist[v].load(memory_order_relaxed) / delta;
+                    if (b >= buckets.size()) buckets.resize(b + 1);
+                    buckets[b].push_back(v);
+                }
+                upd.clear();
+            }
+        };
+        vector<int> frontier, settled;
+        for (size_t b = 0; b < buckets.size(); b++) {
+            settled.clear();
+            while (buckets[b].size()) {
+                frontier.swap(buckets[b]);
+                buckets[b].clear();
+                // drop stale entries (the vertex has moved to an earlier bucket) and duplicates
+                frontier.erase(remove_if(frontier.begin(), frontier.end(), [&](int u) {
+                    return (size_t)(dist[u].load(memory_order_relaxed) / delta) != b; }), frontier.end());
+                sort(frontier.begin(), frontier.end());
+                frontier.erase(unique(frontier.begin(), frontier.end()), frontier.end());
+                parallel_for(frontier.size(), threads, [&](int i, int t) {
+                    int u = frontier[i];
+                    W d = dist[u].load(memory_order_relaxed);
+                    for (int j = g.start[u]; j < g.start[u + 1]; j++)
+                        if (g.adj[j].second < delta) relax(g.adj[j].first, d + g.adj[j].second, t);
+                });
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+                flush();
+            }
+            sort(settled.begin(), settled.end());
+            settled.erase(unique(settled.begin(), settled.end()), settled.end());
+            parallel_for(settled.size(), threads, [&](int i, int t) {
+                int u = settled[i];
+                W d = dist[u].load(memory_order_relaxed);
+                for (int j = g.start[u]; j < g.start[u + 1]; j++)
+                    if (g.adj[j].second >= delta) relax(g.adj[j].first, d + g.adj[j].second, t);
+            });
+            flush();
+        }
+        vector<W> res(n);
+        for (int i = 0; i < n; i++) res[i] = dist[i].load();
+        return res;
+    }
+}; // ShortestPath
\ No newline at end of file
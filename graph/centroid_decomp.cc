@@ -25,4 +25,108 @@ vector<int> centroid_decomp(const vector<vector<int>>& tr) {
     vector<bool> seen(n, false);
     centroid_root = centroid_decomp(0, -1, par, tr, sizes, seen);
     return par;
-}
\ No newline at end of file
+}
+
+// Iterative centroid decomposition over a flat (csr) copy of the tree.
+// Besides the centroid tree it stores the distance from every vertex to each of its centroid ancestors:
+//  - dist[dist_start[u] + k] is the distance from u to its ancestor at level k of the centroid tree (k <= level[u]),
+//    so u only has entries for its own levels
+//  - layer[k] holds, for every centroid c at level k, the (vertex, distance to c) pairs of its component
+//    contiguously in [begin[c], begin[c] + comp_size[c])
+// Memory: O(n*log(n)). Time: O(n*log(n))
+struct CentroidDecomposition {
+    int n, root = -1;
+    vector<int> par;   // par[u] is the parent of u in the centroid tree
+    vector<int> level; // level[u] is the depth of u in the centroid tree
+    vector<int> begin, comp_size;
+    vector<int> dist_start, dist;
+    vector<vector<pair<int, int>>> layer;
+    CentroidDecomposition(const vector<vector<int>>& tr) : n(tr.size()), par(n, -1), level(n), begin(n), comp_size(n), dist_start(n + 1) {
+        vector<int> adj_start(n + 1), adj;
+        for (int u = 0; u < n; u++) adj_start[u + 1] = adj_start[u] + tr[u].size();
+        adj.reserve(adj_start[n]);
+        for (int u = 0; u < n; u++) adj.insert(adj.end(), tr[u].begin(), tr[u].end());
+        vector<char> removed(n, 0);
+        vector<int> q(n), bfs_par(n), sizes(n), d(n);
+        vector<array<int, 3>> stk; // (any vertex of the component, parent centroid, level)
+        if (n) stk.push_back({0, -1, 0});
+        while (stk.size()) {
+            auto [s, p, k] = stk.back();
+            stk.pop_back();
+            int qn = 0; // bfs over the component to get the sizes of the subtrees when rooted at s
+            q[qn++] = s, bfs_par[s] = -1;
+            for (int i = 0; i < qn; i++) {
+                int u = q[i];
+                for (int j = adj_start[u]; j < adj_start[u + 1]; j++) 
+                    if (adj[j] != bfs_par[u] && !removed[adj[j]]) bfs_par[adj[j]] = u, q[qn++] = adj[j];
+            }
+            for (int i = qn - 1; i >= 0; i--) {
+                sizes[q[i]] = 1;
+                for (int j = adj_start[q[i]]; j < adj_start[q[i] + 1]; j++) 
+                    if (adj[j] != bfs_par[q[i]] && !removed[adj[j]]) sizes[q[i]] += sizes[adj[j]];
+            }
+            int c = s; // walk toward the heavy subtree until there is none
+            for (bool moved = true; moved;) {
+                moved = false;
+                for (int j = adj_start[c]; j < adj_start[c + 1]; j++) {
+                    int x = adj[j];
+                    if (x != bfs_par[c] && !removed[x] && sizes[x] > qn / 2) { c = x, moved = true; break; }
+                }
+            }
+            par[c] = p, level[c] = k;
+            if (p == -1) root = c;
+            if (k == (int)layer.size()) layer.emplace_back();
+            begin[c] = layer[k].size(), comp_size[c] = qn;
+            qn = 0; // bfs from the centroid to get the distances
+            q[qn++] = c, bfs_par[c] = -1, d[c] = 0;
+            for (int i = 0; i < qn; i++) {
+                int u = q[i];
+                layer[k].emplace_back(u, d[u]);
+                for (int j = adj_start[u]; j < adj_start[u + 1]; j++) 
+                    if (adj[j] != bfs_par[u] && !removed[adj[j]]) bfs_par[adj[j]] = u, d[adj[j]] = d[u] + 1, q[qn++] = adj[j];
+            }
+            removed[c] = 1;
+            for (int j = adj_start[c]; j < adj_start[c + 1]; j++) if (!removed[adj[j]]) stk.push_back({adj[j], c, k + 1});
+        }
+        for (int u = 0; u < n; u++) dist_start[u + 1] = dist_start[u] + level[u] + 1;
+        dist.resize(dist_start[n]);
+        for (int k = 0; k < (int)layer.size(); k++) for (auto [u, du]:layer[k]) dist[dist_start[u] + k] = du;
+    }
+    int dist_to(int u, int a) { return dist[dist_start[u] + level[a]]; } // a must be a centroid ancestor of u (or u itself)
+}; // CentroidDecomposition
+
+// Distance from a vertex to the nearest marked vertex. Time: O(log(n)) per operation
+struct CentroidNearest {
+    CentroidDecomposition& cd;
+    vector<int> best; // best[a] is the distance from a to the nearest marked vertex in its component
+    CentroidNearest(CentroidDecomposition& _cd) : cd(_cd), best(_cd.n, INT_MAX) {}
+    void mark(int u) {
+        for (int a = u; a != -1; a = cd.par[a]) best[a] = min(best[a], cd.dist_to(u, a));
+    }
+    int nearest(int u) { // INT_MAX if no vertex is marked
+        int res = INT_MAX;
+        for (int a = u; a != -1; a = cd.par[a]) if (best[a] != INT_MAX) res = min(res, best[a] + cd.dist_to(u, a));
+        return res;
+    }
+}; // CentroidNearest
+
+// Sum of distances from a vertex to all marked vertices. Time: O(log(n)) per operation
+struct CentroidDistSum {
+    CentroidDecomposition& cd;
+    vector<long long> cnt, sum, sum_par; // over the marked vertices in a's component: count, sum of distances to a and to par[a]
+    CentroidDistSum(CentroidDecomposition& _cd) : cd(_cd), cnt(_cd.n), sum(_cd.n), sum_par(_cd.n) {}
+    void mark(int u, int times = 1) { // times = -1 unmarks
+        for (int a = u; a != -1; a = cd.par[a]) {
+            cnt[a] += times, sum[a] += times * cd.dist_to(u, a);
+            if (cd.par[a] != -1) sum_par[a] += times * cd.dist_to(u, cd.par[a]);
+        }
+    }
+    long long dist_sum(int u) {
+        long long res = sum[u];
+        for (int a = u; cd.par[a] != -1; a = cd.par[a]) {
+            int p = cd.par[a];
+            res += sum[p] - sum_par[a] + (cnt[p] - cnt[a]) * cd.dist_to(u, p);
+        }
+        return res;
+    }
+}; // CentroidDistSum
\ No newline at end of file
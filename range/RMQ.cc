@@ -21,4 +21,47 @@ struct RMQ {
         return select_index(table[dep][a], table[dep][b - (1 << dep)]);
     }
     T get_val(int a, int b) { return vals[get_index(a, b)]; }
-}; // RMQ
\ No newline at end of file
+}; // RMQ
+
+// Build in O(N). Query in O(1). Memory O(N): a sparse table over blocks of 64 values and one 64-bit mask per value.
+// mask[i] has bit k set when vals[i - k] is smaller than everything in (i - k, i] (the monotonic stack ending at i),
+// so the answer for a range of at most 64 values ending at i is its highest set bit inside the range.
+template<typename T, bool use_min = true>
+struct LinearRMQ {
+    vector<T> vals;
+    vector<unsigned long long> mask;
+    vector<vector<int>> table; // table[k][j] is the answer over blocks [j, j + 2^k)
+    int select_index(int a, int b) { return (use_min ? vals[a] < vals[b] : vals[a] > vals[b]) ? a : b; }
+    LinearRMQ() {}
+    LinearRMQ(vector<T> _vals) { build(move(_vals)); }
+    void build(vector<T> _vals) {
+        vals = move(_vals);
+        int n = vals.size(), nb = (n + 63) / 64;
+        mask.resize(n);
+        unsigned long long cur = 0;
+        for (int i = 0; i < n; i++) {
+            cur <<= 1;
+            while (cur && select_index(i - __builtin_ctzll(cur), i) == i) cur &= cur - 1;
+            mask[i] = cur |= 1;
+        }
+        table.assign(1, vector<int>(nb));
+        for (int b = 0; b < nb; b++) table[0][b] = small(b * 64, min(n, b * 64 + 64) - 1);
+        for (int pw = 1, k = 1; pw * 2 <= nb; pw *= 2, k++) {
+            table.emplace_back(nb - pw * 2 + 1);
+            for (int j = 0; j < (int)table[k].size(); j++)
+                table[k][j] = select_index(table[k - 1][j], table[k - 1][j + pw]);
+        }
+    }
+    int small(int l, int r) { return r - (63 - __builtin_clzll(mask[r] & (~0ULL >> (63 - (r - l))))); } // [l, r], r - l < 64
+    int get_index(int a, int b) { // gets the minimum of the range [a, b)
+        int r = b - 1;
+        if (r - a < 64) return small(a, r);
+        int bl = a / 64 + 1, br = r / 64, res = select_index(small(a, bl * 64 - 1), small(br * 64, r));
+        if (bl < br) {
+            int dep = 31 - __builtin_clz(br - bl);
+            res = select_index(res, select_index(table[dep][bl], table[dep][br - (1 << dep)]));
+        }
+        return res;
+    }
+    T get_val(int a, int b) { return vals[get_index(a, b)]; }
+}; // LinearRMQ
\ No newline at end of file
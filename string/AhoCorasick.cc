@@ -37,14 +37,19 @@ struct AhoCorasick {
         if (data[cur].id != -1) duplicates[data[cur].id].push_back(idx);
         else data[cur].id = idx;
     }
+    bool full = false; // whether every missing transition points to its fallback target (set by build)
     // call after inserting all words into the trie
-    void build() {
+    // with _full, missing transitions are filled with the state that following suffix links would reach,
+    // so process makes exactly one table lookup per character (required by process_streams)
+    void build(bool _full = false) {
+        full = _full;
         queue<int> q;
         q.push(0);
         while (q.size() && data[q.front()].par == 0) { // process the root and its children
             int cur = q.front(); q.pop();
             if (data[cur].id != -1) data[cur].el = cur;
             for (int i = 0; i < alpha; i++) if (data[cur].ch[i] != -1) q.push(data[cur].ch[i]);
+            if (full) fill_missing(cur);
         }
         while (q.size()) {
             int cur = q.front(); q.pop();
@@ -55,8 +60,13 @@ struct AhoCorasick {
             if (data[cur].id != -1) data[cur].el = cur; // a word ends at the current node so it is its own end word link
             else data[cur].el = data[data[cur].sl].el; // there is no word that ends at the current node so its end word link is the end word link of its suffix link node
             for (int i = 0; i < alpha; i++) if (data[cur].ch[i] != -1) q.push(data[cur].ch[i]); // bfs on all children
+            if (full) fill_missing(cur);
         }
     }
+    // the suffix link node is shallower so its transitions are already filled
+    void fill_missing(int cur) {
+        for (int i = 0; i < alpha; i++) if (data[cur].ch[i] == -1) data[cur].ch[i] = cur ? data[data[cur].sl].ch[i] : 0;
+    }
     void process_op(int id, int i) { // MUST BE O(1)
         // CHANGE
     }
@@ -64,9 +74,7 @@ struct AhoCorasick {
     void process(string &t) {
         int cur = 0; // we begin at the root
         for (int i = 0; i < (int)t.size(); i++) {
-            int c = t[i]-base_ch;
-            while (data[cur].ch[c] == -1 && cur > 0) cur = data[cur].sl; // backtrack until we find a path that has c as a child or we reach the root
-            if (data[cur].ch[c] != -1) cur = data[cur].ch[c]; // if we have found a path, move forward
+            cur = step(cur, t[i]);
             int end = data[cur].el; // we will now process all the words that are suffixes of the current path
             while (end > 0) {
                 process_op(data[end].id, i); 
@@ -74,4 +82,213 @@ struct AhoCorasick {
             }
         }
     }
-}; // AhoCorasick
\ No newline at end of file
+    // the node reached from cur by reading ch
+    int step(int cur, char ch) {
+        int c = ch - base_ch;
+        if (full) return data[cur].ch[c];
+        while (data[cur].ch[c] == -1 && cur > 0) cur = data[cur].sl; // backtrack until we find a path that has c as a child or we reach the root
+        if (data[cur].ch[c] != -1) cur = data[cur].ch[c]; // if we have found a path, move forward
+        return cur;
+    }
+    // calls f(word id, pos) for every word that ends at node cur
+    template<typename F>
+    void report(int cur, long long pos, F& f) {
+        for (int end = data[cur].el; end > 0; end = data[data[end].sl].el) f(data[end].id, pos);
+    }
+    // scans K texts in lockstep so the K independent table lookups per step overlap in memory
+    // calls f(text index, word id, end position) for every occurrence, requires build(true)
+    template<int K, typename F>
+    void process_streams(const string* texts, F f) {
+        assert(full);
+        int cur[K] = {}, common = INT_MAX;
+        for (int k = 0; k < K; k++) common = min(common, (int)texts[k].size());
+        auto report = [&](int k, int i) {
+            for (int end = data[cur[k]].el; end > 0; end = data[data[end].sl].el) f(k, data[end].id, i);
+        };
+        for (int i = 0; i < common; i++) {
+            for (int k = 0; k < K; k++) cur[k] = data[cur[k]].ch[texts[k][i] - base_ch];
+            for (int k = 0; k < K; k++) if (data[cur[k]].el > 0) report(k, i);
+        }
+        for (int k = 0; k < K; k++) for (int i = common; i < (int)texts[k].size(); i++) {
+            cur[k] = data[cur[k]].ch[texts[k][i] - base_ch];
+            report(k, i);
+        }
+    }
+}; // AhoCorasick
+
+/**
+* Aho Corasick over a double-array trie
+* Build-then-freeze variant of AhoCorasick for large dictionaries over any byte alphabet. Words are inserted
+* into a linked edge list trie, build() packs it into base/check arrays (state s goes to base[s] + c by code c
+* if check[base[s] + c] == s) and then frees the linked trie. Bytes that occur in no word share code 0, which
+* always leads back to the root, and the other bytes are coded by decreasing frequency to keep the arrays dense.
+* Memory: 20 bytes per slot, slots are usually within a few percent of the number of trie nodes
+* Time: O(N + M*alpha + C), the placement search is usually close to linear
+* Sources:
+*  - J. Aoe, An Efficient Digital Search Algorithm by Using a Double-Array Structure
+*  - https://www.toptal.com/algorithms/aho-corasick-algorithm
+*/
+struct AhoCorasickDA {
+    int code[256] = {}; // the code of each byte, 0 if it occurs in no word
+    int num_codes = 1;
+    vector<int> base, check, fail, out, id; // out[s] is the nearest state on the fail chain of s where a word ends
+    vector<int> lengths;
+    vector<vector<int>> duplicates; // use if duplicates are allowed
+    vector<int> head, e_next, e_to; // building: the linked trie, node 0 is the root
+    vector<unsigned char> e_ch;
+    vector<int> node_id;
+    AhoCorasickDA() : head(1, -1), node_id(1, -1) {}
+
+    void insert(const string& s, int idx) {
+        int cur = 0;
+        for (unsigned char c:s) {
+            int nxt = -1;
+            for (int e = head[cur]; e != -1; e = e_next[e]) if (e_ch[e] == c) { nxt = e_to[e]; break; }
+            if (nxt == -1) {
+                nxt = head.size();
+                head.push_back(-1), node_id.push_back(-1);
+                e_next.push_back(head[cur]), e_ch.push_back(c), e_to.push_back(nxt);
+                head[cur] = e_next.size() - 1;
+            }
+            cur = nxt;
+        }
+        duplicates.emplace_back();
+        lengths.push_back(s.size());
+        if (node_id[cur] != -1) duplicates[node_id[cur]].push_back(idx);
+        else node_id[cur] = idx;
+    }
+
+    bool has(int s, int c) { return base[s] + c < (int)check.size() && check[base[s] + c] == s; }
+    vector<int> next_free; // building: next_free[p] leads to the first free slot >= p (path compressed)
+    void grow(int sz) {
+        if (sz <= (int)check.size()) return;
+        sz = max(sz, 2 * (int)check.size());
+        int old = check.size();
+        base.resize(sz, 0), check.resize(sz, -1), next_free.resize(sz + 1);
+        iota(next_free.begin() + old, next_free.end(), old);
+    }
+    int find_free(int p) {
+        grow(p + 1);
+        int r = p;
+        while (next_free[r] != r) r = next_free[r];
+        while (next_free[p] != r) { int nxt = next_free[p]; next_free[p] = r; p = nxt; }
+        return r;
+    }
+    // call after inserting all words
+    void build() {
+        long long freq[256] = {};
+        for (unsigned char c:e_ch) freq[c]++;
+        vector<int> bytes;
+        for (int c = 0; c < 256; c++) if (freq[c]) bytes.push_back(c);
+        sort(bytes.begin(), bytes.end(), [&](int a, int b) { return freq[a] > freq[b]; });
+        for (int c:bytes) code[c] = num_codes++;
+        // place the states in bfs order, slot[u] is the slot of trie node u
+        int n = head.size();
+        vector<int> slot(n, -1), q(1, 0);
+        vector<pair<int, int>> kids; // (code, trie node)
+        grow(num_codes + 1);
+        check[0] = 0, slot[0] = 0, next_free[0] = 1;
+        int first = num_codes + 1; // slots up to num_codes could only be reached from bases below 1
+        int first_multi = first;   // where nodes with several children start searching, moves on when the search gets long
+        for (int i = 0; i < (int)q.size(); i++) {
+            int u = q[i], s = slot[u];
+            kids.clear();
+            for (int e = head[u]; e != -1; e = e_next[e]) kids.emplace_back(code[e_ch[e]], e_to[e]);
+            if (kids.empty()) continue;
+            sort(kids.begin(), kids.end());
+            // try the bases that put the first child on a free slot until every child fits,
+            // single children always fit the first free slot and fill the holes left behind
+            int tries = 0;
+            for (int p = find_free(kids.size() == 1 ? first : first_multi);; p = find_free(p + 1), tries++) {
+                int b = p - kids[0].first;
+                grow(b + kids.back().first + 1);
+                bool ok = true;
+                for (auto& [c, v]:kids) if (check[b + c] != -1) { ok = false; break; }
+                if (!ok) continue;
+                if (tries > 32) first_multi = p;
+                base[s] = b;
+                for (auto& [c, v]:kids) check[b + c] = s, next_free[b + c] = b + c + 1, slot[v] = b + c, q.push_back(v);
+                break;
+            }
+        }
+        int sz = *max_element(slot.begin(), slot.end()) + 1; // drop the unused capacity
+        base.resize(sz), check.resize(sz);
+        base.shrink_to_fit(), check.shrink_to_fit();
+        fail.assign(sz, 0), out.assign(sz, -1), id.assign(sz, -1);
+        for (int u = 0; u < n; u++) id[slot[u]] = node_id[u];
+        for (int u:q) for (int e = head[u]; e != -1; e = e_next[e]) { // bfs order, parents come first
+            int s = slot[u], c = code[e_ch[e]], t = slot[e_to[e]], f = fail[s];
+            while (f && !has(f, c)) f = fail[f];
+            fail[t] = s && has(f, c) ? base[f] + c : 0;
+            out[t] = id[fail[t]] != -1 ? fail[t] : out[fail[t]];
+        }
+        vector<int>().swap(next_free);
+        vector<int>().swap(head), vector<int>().swap(e_next), vector<int>().swap(e_to);
+        vector<unsigned char>().swap(e_ch), vector<int>().swap(node_id);
+    }
+
+    int step(int cur, unsigned char ch) {
+        int c = code[ch];
+        if (!c) return 0;
+        while (cur && !has(cur, c)) cur = fail[cur];
+        return has(cur, c) ? base[cur] + c : 0;
+    }
+    // calls f(word id, pos) for every word that ends at state cur
+    template<typename F>
+    void report(int cur, long long pos, F& f) {
+        for (int s = id[cur] != -1 ? cur : out[cur]; s > 0; s = out[s]) f(id[s], pos);
+    }
+    // calls f(word id, end position) for every occurrence of a word in t
+    template<typename F>
+    void process(const string& t, F f) {
+        int cur = 0;
+        for (int i = 0; i < (int)t.size(); i++) {
+            cur = step(cur, t[i]);
+            report(cur, i, f);
+        }
+    }
+}; // AhoCorasickDA
+
+// Resumable scanner over AhoCorasick or AhoCorasickDA for texts that arrive in chunks (pipes, mmap windows, ...).
+// The automaton state carries over between chunks, so words spanning chunk boundaries are found and no text is copied.
+// f(word id, end position) is called for every occurrence, positions count from the start of the stream.
+// Usage: auto sc = make_scanner(ac, [&](int id, long long pos) { ... }); while (read chunk) sc.feed(chunk);
+template<typename AC, typename F>
+struct ACScanner {
+    AC& ac;
+    F f;
+    int cur = 0;      // the automaton state after the bytes fed so far
+    long long pos = 0; // the number of bytes fed so far
+    ACScanner(AC& _ac, F _f) : ac(_ac), f(_f) {}
+    void feed(string_view chunk) {
+        for (char c:chunk) {
+            cur = ac.step(cur, c);
+            ac.report(cur, pos++, f);
+        }
+    }
+    void reset() { cur = 0, pos = 0; }
+}; // ACScanner
+template<typename AC, typename F>
+ACScanner<AC, F> make_scanner(AC& ac, F f) { return ACScanner<AC, F>(ac, f); }
+
+// Scans text with several threads sharing one built automaton (AhoCorasick or AhoCorasickDA), which is only read.
+// Thread t owns the matches ending in its chunk and starts scanning (longest word - 1) bytes early so that words
+// crossing the chunk boundary are found exactly once.
+// f(thread, word id, end position) is called from the thread that owns the match (compile with -pthread).
+template<typename AC, typename F>
+void parallel_scan(AC& ac, string_view text, int threads, F f) {
+    long long n = text.size(), overlap = 0;
+    for (int l:ac.lengths) overlap = max(overlap, (long long)l - 1);
+    threads = max(1, (int)min<long long>(threads, n / max(overlap + 1, 1LL << 16) + 1)); // chunks much longer than the overlap
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) pool.emplace_back([&, t] {
+        long long lo = n * t / threads, hi = n * (t + 1) / threads;
+        int cur = 0;
+        auto g = [&](int id, long long pos) { if (pos >= lo) f(t, id, pos); };
+        for (long long i = max(0LL, lo - overlap); i < hi; i++) {
+            cur = ac.step(cur, text[i]);
+            ac.report(cur, i, g);
+        }
+    });
+    for (auto& th:pool) th.join();
+}
\ No newline at end of file
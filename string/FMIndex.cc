@@ -0,0 +1,180 @@
+/**
+* FM-index
+* Substring count/locate over a byte string using its Burrows-Wheeler transform instead of the text and the suffix array.
+* The BWT (built from a suffix array, e.g. atcoder::suffix_array) is stored in a wavelet matrix of 8 rank bitvectors
+* and every sample-th text position of the suffix array is kept for locate, so the index takes about
+* (1.15 + 8 / sample) * N bytes (1.4N for sample = 32) and the text is not needed after the build.
+* The end of the text is a sentinel smaller than every byte, so any bytes (including 0) work.
+* save/load use a binary format (native endianness): "FMINDEX1", n, sample, primary, then the bitvectors and samples.
+* Time: build O(N), count O(M), locate O(M + occ*sample)
+* Sources:
+*  - P. Ferragina and G. Manzini, Opportunistic Data Structures with Applications
+*  - F. Claude, G. Navarro and A. Ordonez, The wavelet matrix
+*/
+struct FMIndex {
+    // bitvector with a cumulative count every 512 bits
+    struct BitRank {
+        vector<uint64_t> bits;
+        vector<long long> blocks; // blocks[b] is the number of ones in words [0, 8b)
+        void init(long long n) { bits.assign(n / 64 + 1, 0); }
+        void set(long long i) { bits[i >> 6] |= 1ULL << (i & 63); }
+        bool get(long long i) const { return bits[i >> 6] >> (i & 63) & 1; }
+        void build() {
+            blocks.assign((bits.size() + 7) / 8 + 1, 0);
+            for (size_t w = 0; w < bits.size(); w++) blocks[w / 8 + 1] = (w % 8 ? blocks[w / 8 + 1] : blocks[w / 8]) + __builtin_popcountll(bits[w]);
+        }
+        long long rank1(long long i) const { // the number of ones in [0, i)
+            long long w = i >> 6, res = blocks[w >> 3];
+            for (long long k = w & ~7LL; k < w; k++) res += __builtin_popcountll(bits[k]);
+            return res + __builtin_popcountll(bits[w] & ((1ULL << (i & 63)) - 1));
+        }
+        long long rank0(long long i) const { return i - rank1(i); }
+    }; // BitRank
+
+    long long n = 0;        // the length of the text, the BWT has n + 1 rows
+    long long primary = 0;  // the row of the whole text, its BWT character is the sentinel (stored as 0)
+    int sample = 32;
+    array<long long, 257> C{}; // C[c] is the first row of the suffixes starting with byte c
+    BitRank level[8];          // the wavelet matrix, level 0 holds the highest bit
+    long long zeros[8] = {};
+    BitRank sampled;           // the rows whose suffix array entry is kept
+    vector<long long> samples;
+
+    FMIndex() {}
+    // sa is the suffix array of s
+    template<typename Idx>
+    FMIndex(string_view s, const vector<Idx>& sa, int _sample = 32) : n(s.size()), sample(_sample) {
+        vector<uint8_t> cur(n + 1), nxt(n + 1);
+        sampled.init(n + 1);
+        for (long long row = 0; row <= n; row++) { // row 0 is the empty suffix
+            long long p = row == 0 ? n : sa[row - 1];
+            if (p == 0) primary = row, cur[row] = 0;
+            else cur[row] = s[p - 1];
+            if (p % sample == 0) sampled.set(row), samples.push_back(p);
+        }
+        sampled.build();
+        for (unsigned char c:s) C[c + 1]++;
+        C[0] = 1;
+        for (int c = 0; c < 256; c++) C[c + 1] += C[c];
+        for (int l = 0; l < 8; l++) { // stable partition of the rows by bit 7 - l
+            level[l].init(n + 1);
+            long long z = 0;
+            for (long long i = 0; i <= n; i++) if (cur[i] >> (7 - l) & 1) level[l].set(i); else nxt[z++] = cur[i];
+            zeros[l] = z;
+            for (long long i = 0; i <= n; i++) if (cur[i] >> (7 - l) & 1) nxt[z++] = cur[i];
+            level[l].build();
+            cur.swap(nxt);
+        }
+    }
+
+    // the number of rows in [0, lo) and [0, hi) whose BWT character is c
+    pair<long long, long long> rank(unsigned char c, long long lo, long long hi) const {
+        long long st = 0, dlo = c == 0 && primary < lo, dhi = c == 0 && primary < hi; // the sentinel is not a 0 byte
+        for (int l = 0; l < 8; l++) {
+            if (c >> (7 - l) & 1) st = zeros[l] + level[l].rank1(st), lo = zeros[l] + level[l].rank1(lo), hi = zeros[l] + level[l].rank1(hi);
+            else st = level[l].rank0(st), lo = level[l].rank0(lo), hi = level[l].rank0(hi);
+        }
+        return {lo - st - dlo, hi - st - dhi};
+    }
+    unsigned char access(long long i) const {
+        unsigned char c = 0;
+        for (int l = 0; l < 8; l++) {
+            bool b = level[l].get(i);
+            c = c << 1 | b;
+            i = b ? zeros[l] + level[l].rank1(i) : level[l].rank0(i);
+        }
+        return c;
+    }
+    long long lf(long long row) const { // the row of the suffix one position earlier, row must not be primary
+        unsigned char c = access(row);
+        return C[c] + rank(c, row, row).first;
+    }
+
+    // the rows [lo, hi) of the suffixes starting with p (backward search)
+    pair<long long, long long> range(string_view p) const {
+        long long lo = 0, hi = n + 1;
+        for (int i = (int) p.size() - 1; i >= 0 && lo < hi; i--) {
+            unsigned char c = p[i];
+            auto [a, b] = rank(c, lo, hi);
+            lo = C[c] + a, hi = C[c] + b;
+        }
+        return {lo, hi};
+    }
+    long long count(string_view p) const {
+        auto [lo, hi] = range(p);
+        return max(0LL, hi - lo);
+    }
+    long long locate_row(long long row) const {
+        long long steps = 0;
+        for (; !sampled.get(row); steps++) row = lf(row);
+        return samples[sampled.rank1(row)] + steps;
+    }
+    // the starting positions of the occurrences of p in increasing order
+    vector<long long> locate(string_view p) const {
+        auto [lo, hi] = range(p);
+        vector<long long> res;
+        for (long long row = lo; row < hi; row++) res.push_back(locate_row(row));
+        sort(res.begin(), res.end());
+        return res;
+    }
+
+    // returns whether the index was written
+    bool save(const string& path) const {
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f) return false;
+        int64_t head[4] = {n, sample, primary, (int64_t) samples.size()};
+        bool ok = fwrite("FMINDEX1", 1, 8, f) == 8 && fwrite(head, sizeof(head), 1, f) == 1;
+        auto put = [&](const vector<uint64_t>& v) { ok = ok && fwrite(v.data(), sizeof(uint64_t), v.size(), f) == v.size(); };
+        for (int l = 0; l < 8; l++) {
+            int64_t z = zeros[l];
+            ok = ok && fwrite(&z, sizeof(z), 1, f) == 1;
+            put(level[l].bits);
+        }
+        put(sampled.bits);
+        ok = ok && fwrite(samples.data(), sizeof(long long), samples.size(), f) == samples.size();
+        return fclose(f) == 0 && ok;
+    }
+    // returns false if the file cannot be read or is not an FM-index
+    bool load(const string& path) {
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) return false;
+        fseek(f, 0, SEEK_END);
+        long long size = ftell(f); // the header must match the file size before anything is allocated
+        rewind(f);
+        char magic[8];
+        int64_t head[4];
+        bool ok = size >= 0 && fread(magic, 1, 8, f) == 8 && memcmp(magic, "FMINDEX1", 8) == 0 && fread(head, sizeof(head), 1, f) == 1
+            && head[0] >= 0 && head[0] < size * 8 && head[1] > 0 && 0 <= head[2] && head[2] <= head[0] && head[3] >= 0 && head[3] <= size / 8
+            && size == 40 + 8 * 8 + 9 * ((head[0] + 1) / 64 + 1) * 8 + head[3] * 8;
+        auto get = [&](BitRank& b) {
+            b.init(n + 1);
+            ok = ok && fread(b.bits.data(), sizeof(uint64_t), b.bits.size(), f) == b.bits.size();
+            b.build();
+        };
+        if (ok) {
+            n = head[0], sample = head[1], primary = head[2];
+            for (int l = 0; l < 8; l++) {
+                int64_t z;
+                ok = ok && fread(&z, sizeof(z), 1, f) == 1;
+                get(level[l]);
+                zeros[l] = level[l].rank0(n + 1); // keeps every rank() index in [0, n + 1]
+                ok = ok && z == zeros[l];
+            }
+            get(sampled);
+            samples.resize(head[3]);
+            ok = ok && fread(samples.data(), sizeof(long long), samples.size(), f) == samples.size()
+                && (long long)samples.size() == sampled.rank1(n + 1);
+        }
+        fclose(f);
+        if (!ok) {
+            *this = FMIndex();
+            return false;
+        }
+        C.fill(0), C[0] = 1; // the character counts are recovered from the BWT
+        for (int c = 0; c < 256; c++) {
+            auto [a, b] = rank(c, 0, n + 1);
+            C[c + 1] = C[c] + b - a;
+        }
+        return true;
+    }
+}; // FMIndex
\ No newline at end of file
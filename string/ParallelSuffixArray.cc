@@ -0,0 +1,138 @@
+/**
+* Parallel Suffix Array
+* Prefix doubling in the style of Larsson-Sadakane: the suffixes are bucketed by their first two characters
+* with a parallel counting sort, then every round sorts each group of suffixes that still share their first h
+* characters by the rank of the suffix h positions later and doubles h. Groups are sorted independently by the
+* threads (a group larger than a thread's share is radix sorted by all of them) and a suffix that is alone in
+* its group is never touched again, so typical text is done after a few rounds over a shrinking set.
+* Characters are compared as unsigned values, the result is the same as atcoder::suffix_array.
+* Idx is int, or long long for inputs with 2^31 or more characters. Compile with -pthread.
+* Time: O(N*log(N)^2/threads) worst case (e.g. a string of one repeated character)
+* Memory: at most 6 * N * sizeof(Idx) bytes on top of the input, which is not copied.
+* Sources:
+*  - N. J. Larsson and K. Sadakane, Faster Suffix Sorting
+*  - https://cp-algorithms.com/string/suffix-array.html (prefix doubling)
+*/
+template<typename Idx = int>
+struct ParallelSuffixArray {
+    // runs f(lo, hi, t) on [0, n) split into contiguous blocks over the threads, t is the thread index
+    template<typename Fn>
+    static void parallel_blocks(long long n, int threads, Fn f) {
+        if (threads <= 1 || n < 4096) {
+            f(0LL, n, 0);
+            return;
+        }
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back([&, t] { f(n * t / threads, n * (t + 1) / threads, t); });
+        for (auto& th:pool) th.join();
+    }
+
+    // runs f(i, t) for i in [0, n), the threads take blocks of grain indices from a shared counter
+    template<typename Fn>
+    static void parallel_dynamic(long long n, int threads, long long grain, Fn f) {
+        if (threads <= 1 || n <= grain) {
+            for (long long i = 0; i < n; i++) f(i, 0);
+            return;
+        }
+        atomic<long long> next(0);
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back([&, t] {
+            for (long long lo; (lo = next.fetch_add(grain)) < n;)
+                for (long long i = lo; i < min(n, lo + grain); i++) f(i, t);
+        });
+        for (auto& th:pool) th.join();
+    }
+
+    // sorts a[0, len) by the first element (in [-1, n)) with a parallel LSD radix sort, 8 bits per pass
+    static void radix_sort(pair<Idx, Idx>* a, pair<Idx, Idx>* tmp, long long len, long long n, int threads) {
+        vector<long long> cnt((size_t) threads * 256);
+        pair<Idx, Idx>* src = a;
+        for (int shift = 0; shift < 64 && (unsigned long long) n >> shift; shift += 8) {
+            fill(cnt.begin(), cnt.end(), 0);
+            auto digit = [&](const pair<Idx, Idx>& x) { return (unsigned long long) (x.first + 1) >> shift & 255; };
+            parallel_blocks(len, threads, [&](long long lo, long long hi, int t) { for (long long i = lo; i < hi; i++) cnt[t * 256 + digit(src[i])]++; });
+            long long pos = 0;
+            for (int d = 0; d < 256; d++) for (int t = 0; t < threads; t++) {
+                long long c = cnt[t * 256 + d];
+                cnt[t * 256 + d] = pos, pos += c;
+            }
+            parallel_blocks(len, threads, [&](long long lo, long long hi, int t) { for (long long i = lo; i < hi; i++) tmp[cnt[t * 256 + digit(src[i])]++] = src[i]; });
+            swap(src, tmp);
+        }
+        if (src != a) copy(src, src + len, a);
+    }
+
+    template<typename Char>
+    static vector<Idx> build(basic_string_view<Char> str, int threads = thread::hardware_concurrency()) {
+        using U = make_unsigned_t<Char>;
+        static_assert(sizeof(U) <= 2, "use atcoder::suffix_array(const std::vector<T>&) for larger alphabets");
+        assert(str.size() <= size_t(numeric_limits<Idx>::max()));
+        const U* s = (const U*) str.data();
+        Idx n = str.size();
+        threads = max(threads, 1);
+        vector<Idx> sa(n), rnk(n);
+        if (n == 0) return sa;
+
+        // bucket by the first two bytes (0 marks the end of the string) or the first 16-bit character
+        const int K = sizeof(U) == 1 ? 256 * 257 : 65536;
+        Idx h = sizeof(U) == 1 ? 2 : 1;
+        auto key0 = [&](Idx i) { return sizeof(U) == 1 ? s[i] * 257 + (i + 1 < n ? s[i + 1] + 1 : 0) : (int) s[i]; };
+        vector<Idx> cnt((size_t) threads * K), bstart(K + 1);
+        parallel_blocks(n, threads, [&](Idx lo, Idx hi, int t) { for (Idx i = lo; i < hi; i++) cnt[(size_t) t * K + key0(i)]++; });
+        Idx pos = 0;
+        for (int k = 0; k < K; k++) {
+            bstart[k] = pos;
+            for (int t = 0; t < threads; t++) {
+                Idx c = cnt[(size_t) t * K + k];
+                cnt[(size_t) t * K + k] = pos, pos += c;
+            }
+        }
+        bstart[K] = n;
+        parallel_blocks(n, threads, [&](Idx lo, Idx hi, int t) {
+            for (Idx i = lo; i < hi; i++) {
+                int k = key0(i);
+                sa[cnt[(size_t) t * K + k]++] = i, rnk[i] = bstart[k];
+            }
+        });
+        vector<Idx>().swap(cnt);
+        vector<pair<Idx, Idx>> segs; // the groups (start, size) with more than one suffix
+        for (int k = 0; k < K; k++) if (bstart[k + 1] - bstart[k] > 1) segs.emplace_back(bstart[k], bstart[k + 1] - bstart[k]);
+
+        vector<pair<Idx, Idx>> buf(n), tmp; // buf[j] is (the rank of sa[j] + h, sa[j]) for the suffixes in a group
+        vector<vector<pair<Idx, Idx>>> next_segs(threads);
+        const long long big = max(1LL << 16, (long long) n / threads);
+        auto keys = [&](Idx lo, Idx hi) {
+            for (Idx j = lo; j < hi; j++) buf[j] = {sa[j] + h < n ? rnk[sa[j] + h] : -1, sa[j]};
+        };
+        // writes the sorted group back and splits it, the rank of a suffix is the start of its new group
+        auto split = [&](Idx st, Idx len, int t) {
+            for (Idx j = st, k; j < st + len; j = k) {
+                for (k = j; k < st + len && buf[k].first == buf[j].first; k++) sa[k] = buf[k].second, rnk[sa[k]] = j;
+                if (k - j > 1) next_segs[t].emplace_back(j, k - j);
+            }
+        };
+        for (; segs.size(); h *= 2) {
+            vector<pair<Idx, Idx>> small, large;
+            for (auto& sg:segs) (sg.second >= big ? large : small).push_back(sg);
+            // every key is read before any rank of this round is changed
+            parallel_dynamic(small.size(), threads, 64, [&](long long i, int) { keys(small[i].first, small[i].first + small[i].second); });
+            for (auto [st, len]:large) parallel_blocks(len, threads, [&](Idx lo, Idx hi, int) { keys(st + lo, st + hi); });
+            parallel_dynamic(small.size(), threads, 64, [&](long long i, int t) {
+                auto [st, len] = small[i];
+                sort(buf.begin() + st, buf.begin() + st + len);
+                split(st, len, t);
+            });
+            for (auto [st, len]:large) {
+                if ((Idx) tmp.size() < len) tmp.resize(len);
+                radix_sort(buf.data() + st, tmp.data(), len, n, threads), split(st, len, 0);
+            }
+            segs.clear();
+            for (auto& v:next_segs) segs.insert(segs.end(), v.begin(), v.end()), v.clear();
+        }
+        return sa;
+    }
+
+    static vector<Idx> build(const string& s, int threads = thread::hardware_concurrency()) {
+        return build(string_view(s), threads);
+    }
+}; // ParallelSuffixArray
\ No newline at end of file
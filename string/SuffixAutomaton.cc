@@ -0,0 +1,119 @@
+/**
+* Suffix Automaton
+* The minimal automaton accepting all substrings of s, with at most 2N states and 3N transitions.
+* Transitions are not stored as an alpha-sized array per state (compare AhoCorasick::Node) but as linked
+* edge lists in one arena while building, then frozen into per-state contiguous arrays sorted by character
+* (20 bytes per state including counts and 5 bytes per transition), so any byte alphabet works.
+* Time: build O(N*alpha) worst case (O(N) for small alphabets), queries O(M*log(alpha))
+* Sources:
+*  - https://cp-algorithms.com/string/suffix-automaton.html
+*/
+struct SuffixAutomaton {
+    vector<int> len, link; // the length of the longest string of each state and its suffix link
+    vector<int> head;      // building: the first edge of each state
+    vector<int> e_next, e_to;
+    vector<unsigned char> e_ch;
+    vector<int> edge_start, edge_to; // frozen: the transitions of v are [edge_start[v], edge_start[v + 1])
+    vector<unsigned char> edge_ch;
+    vector<long long> cnt; // cnt[v] is the number of occurrences of the strings of v in s
+    int last = 0;
+
+    SuffixAutomaton() {}
+    SuffixAutomaton(const string& s) {
+        len.reserve(2 * s.size() + 1), link.reserve(2 * s.size() + 1), head.reserve(2 * s.size() + 1);
+        new_state(0, -1);
+        vector<char> is_clone(1, 0);
+        for (unsigned char c:s) {
+            int cur = new_state(len[last] + 1, -1), p = last;
+            is_clone.push_back(0);
+            for (; p != -1 && get_building(p, c) == -1; p = link[p]) add_edge(p, c, cur);
+            if (p == -1) link[cur] = 0;
+            else {
+                int q = get_building(p, c);
+                if (len[p] + 1 == len[q]) link[cur] = q;
+                else {
+                    int clone = new_state(len[p] + 1, link[q]);
+                    is_clone.push_back(1);
+                    for (int e = head[q]; e != -1; e = e_next[e]) add_edge(clone, e_ch[e], e_to[e]);
+                    for (; p != -1 && set_building(p, c, q, clone); p = link[p]);
+                    link[q] = link[cur] = clone;
+                }
+            }
+            last = cur;
+        }
+        freeze();
+        count_occurrences(is_clone);
+    }
+    int new_state(int l, int lk) {
+        len.push_back(l), link.push_back(lk), head.push_back(-1);
+        return len.size() - 1;
+    }
+    void add_edge(int v, unsigned char c, int to) {
+        e_next.push_back(head[v]), e_ch.push_back(c), e_to.push_back(to);
+        head[v] = e_next.size() - 1;
+    }
+    int get_building(int v, unsigned char c) {
+        for (int e = head[v]; e != -1; e = e_next[e]) if (e_ch[e] == c) return e_to[e];
+        return -1;
+    }
+    bool set_building(int v, unsigned char c, int from, int to) { // redirects v's c edge if it points to from
+        for (int e = head[v]; e != -1; e = e_next[e]) if (e_ch[e] == c) {
+            if (e_to[e] != from) return false;
+            e_to[e] = to;
+            return true;
+        }
+        return false;
+    }
+    void freeze() { // moves the edge lists into sorted contiguous arrays and frees them
+        int n = len.size();
+        edge_start.assign(n + 1, 0);
+        for (int v = 0; v < n; v++) for (int e = head[v]; e != -1; e = e_next[e]) edge_start[v + 1]++;
+        for (int v = 0; v < n; v++) edge_start[v + 1] += edge_start[v];
+        edge_to.resize(e_to.size()), edge_ch.resize(e_ch.size());
+        vector<pair<unsigned char, int>> tmp;
+        for (int v = 0; v < n; v++) {
+            tmp.clear();
+            for (int e = head[v]; e != -1; e = e_next[e]) tmp.emplace_back(e_ch[e], e_to[e]);
+            sort(tmp.begin(), tmp.end());
+            for (int i = 0; i < (int)tmp.size(); i++) edge_ch[edge_start[v] + i] = tmp[i].first, edge_to[edge_start[v] + i] = tmp[i].second;
+        }
+        vector<int>().swap(head), vector<int>().swap(e_next), vector<int>().swap(e_to), vector<unsigned char>().swap(e_ch);
+    }
+    int next(int v, unsigned char c) { // the transition from v by c, -1 if there is none
+        int lo = edge_start[v], hi = edge_start[v + 1];
+        int i = lower_bound(edge_ch.begin() + lo, edge_ch.begin() + hi, c) - edge_ch.begin();
+        return i < hi && edge_ch[i] == c ? edge_to[i] : -1;
+    }
+    void count_occurrences(const vector<char>& is_clone) { // pushes counts up the suffix links by decreasing length
+        int n = len.size();
+        vector<int> bucket(len[last] + 2, 0), order(n);
+        for (int v = 0; v < n; v++) bucket[len[v] + 1]++;
+        for (int i = 0; i + 1 < (int)bucket.size(); i++) bucket[i + 1] += bucket[i];
+        for (int v = 0; v < n; v++) order[bucket[len[v]]++] = v;
+        cnt.assign(n, 0);
+        for (int v = 1; v < n; v++) cnt[v] = !is_clone[v];
+        for (int i = n - 1; i > 0; i--) cnt[link[order[i]]] += cnt[order[i]];
+    }
+
+    long long distinct_substrings() { // the number of distinct non-empty substrings
+        long long res = 0;
+        for (int v = 1; v < (int)len.size(); v++) res += len[v] - len[link[v]];
+        return res;
+    }
+    long long occurrences(const string& t) { // the number of occurrences of t in s
+        int v = 0;
+        for (unsigned char c:t) if ((v = next(v, c)) == -1) return 0;
+        return t.empty() ? len[last] + 1 : cnt[v];
+    }
+    // returns (length, end position in t) of a longest common substring of s and t
+    pair<int, int> longest_common_substring(const string& t) {
+        int v = 0, l = 0, best = 0, best_end = 0;
+        for (int i = 0; i < (int)t.size(); i++) {
+            unsigned char c = t[i];
+            while (v && next(v, c) == -1) v = link[v], l = len[v];
+            if (next(v, c) != -1) v = next(v, c), l++;
+            if (l > best) best = l, best_end = i + 1;
+        }
+        return {best, best_end};
+    }
+}; // SuffixAutomaton
\ No newline at end of file
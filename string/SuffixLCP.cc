@@ -0,0 +1,38 @@
+/**
+* Suffix LCP
+* Longest common prefix of any two suffixes and lexicographic comparison of any two substrings in O(1),
+* from the suffix array, its lcp array and a linear memory RMQ over it. Unlike comp_hash in string/hash.cc
+* the answers are exact (no hash collisions) and need no binary search.
+* To compare substrings of two different strings, build on their concatenation with a separator.
+* Requires atcoder/string.cc and LinearRMQ from range/RMQ.cc.
+* Time: build O(N), queries O(1)
+* Memory: about 21 bytes per character (suffix array, ranks, lcp values and RMQ masks)
+* Sources:
+*  - https://cp-algorithms.com/string/suffix-array.html (comparing two substrings, lcp of two substrings)
+*/
+struct SuffixLCP {
+    int n;
+    vector<int> sa, rnk; // rnk[i] is the position of suffix i in sa
+    LinearRMQ<int> rmq;  // over lcp[k], the lcp of the suffixes sa[k] and sa[k + 1]
+
+    SuffixLCP(const string& s) : n(s.size()), sa(atcoder::suffix_array(s)), rnk(n) {
+        for (int i = 0; i < n; i++) rnk[sa[i]] = i;
+        if (n) rmq.build(atcoder::lcp_array(s, sa));
+    }
+
+    // the length of the longest common prefix of the suffixes starting at i and j
+    int lcp(int i, int j) {
+        if (i == j) return n - i;
+        if (i == n || j == n) return 0;
+        int a = rnk[i], b = rnk[j];
+        if (a > b) swap(a, b);
+        return rmq.get_val(a, b);
+    }
+    // compares s[a, a + alen) with s[b, b + blen), returns -1, 0 or 1
+    int compare(int a, int alen, int b, int blen) {
+        int len = min(alen, blen);
+        if (lcp(a, b) >= len) return alen < blen ? -1 : alen > blen;
+        return rnk[a] < rnk[b] ? -1 : 1;
+    }
+    bool less(int a, int alen, int b, int blen) { return compare(a, alen, b, blen) < 0; }
+}; // SuffixLCP
\ No newline at end of file
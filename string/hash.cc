@@ -67,9 +67,64 @@ bool comp_hash(string& one, PolyHash& one_hash, int one_start, int one_substr_le
     return one[one_start + loc - 1] < two[two_start + loc - 1];
 }
 
+// Rolling String Hashing modulo the Mersenne prime 2^61 - 1
+// A single hash is enough (a collision has probability about len / 2^61), and the products are reduced with a shift
+// and a mask instead of %. The prefixes are built by 4 independent chains over 4 blocks of the string, then each
+// block adds the hash of everything before it, so the multiplications overlap instead of waiting on each other.
+// The powers of base are a static cache shared by every instance.
+// Time:
+// 	- Build: O(N)
+// 	- Query: O(1)
+// Source: https://codeforces.com/blog/entry/60445
+struct MersenneHash {
+    static const ull mod = (1ULL << 61) - 1;
+    static vector<ull> pw; // powers of base modulo mod
+    static ull base;
+
+    vector<ull> pref; // pref[i] is the hash of the prefix of length i
+
+    static ull add(ull a, ull b) { a += b; return a >= mod ? a - mod : a; }
+    static ull mul(ull a, ull b) {
+        __uint128_t c = (__uint128_t)a * b;
+        ull r = (ull)(c & mod) + (ull)(c >> 61);
+        return r >= mod ? r - mod : r;
+    }
+    // extends pw to [0, n], pw[i] only depends on pw[i - 4] so 4 multiplications are in flight at once
+    static void grow_pow(int n) {
+        int old = pw.size();
+        if (old > n) return;
+        pw.resize(max(n + 1, 2 * old));
+        for (int i = old; i < min((int)pw.size(), 5); i++) pw[i] = mul(pw[i - 1], base);
+        for (int i = max(old, 5); i < (int)pw.size(); i++) pw[i] = mul(pw[i - 4], pw[4]);
+    }
+
+    MersenneHash(const string& s) : pref(s.size() + 1, 0) {
+        int n = s.size(), L = n / 4;
+        grow_pow(n);
+        const unsigned char* c = (const unsigned char*)s.data();
+        ull h0 = 0, h1 = 0, h2 = 0, h3 = 0; // the hash of each block on its own
+        for (int t = 0; t < L; t++) {
+            h0 = add(mul(h0, base), c[t] + 1), pref[t + 1] = h0;
+            h1 = add(mul(h1, base), c[L + t] + 1), pref[L + t + 1] = h1;
+            h2 = add(mul(h2, base), c[2 * L + t] + 1), pref[2 * L + t + 1] = h2;
+            h3 = add(mul(h3, base), c[3 * L + t] + 1), pref[3 * L + t + 1] = h3;
+        }
+        for (int j = 1; j < 4; j++) { // pref[j * L] is final once block j - 1 is done
+            ull before = pref[j * L];
+            for (int t = 1; t <= L; t++) pref[j * L + t] = add(pref[j * L + t], mul(before, pw[t]));
+        }
+        for (int i = 4 * L; i < n; i++) pref[i + 1] = add(mul(pref[i], base), c[i] + 1);
+    }
+
+    // Polynomial hash of subsequence [pos, pos+len)
+    ull get(int pos, int len) { return add(pref[pos + len], mod - mul(pref[pos], pw[len])); }
+}; // MersenneHash
+
 vector<int> PolyHash::pow1{1};
 vector<ull> PolyHash::pow2{1};
 int PolyHash::base((int)1e9+7);
+vector<ull> MersenneHash::pw{1};
+ull MersenneHash::base(mt19937_64(chrono::steady_clock::now().time_since_epoch().count())() % (MersenneHash::mod - 256) + 256);
 //DO: 
 //mx_pow = maximum length of the strings being hashed
 //PolyHash::base = gen_base(256, PolyHash::mod);
\ No newline at end of file
@@ -1,21 +1,25 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 // Provides various operations for searching within strings.
 // Sources:
 // - https://cp-algorithms.com/string/prefix-function.html (lps, kmp, occs, unique)
 // - https://cp-algorithms.com/string/z-function.html
 // - https://cp-algorithms.com/string/manacher.html
+// - http://0x80.pl/articles/simd-strfind.html (find_all)
 struct string_search {
     vector<int> pi;
     vector<int> zarray;
-    vector<int> locs; // the locations of the target pattern from kmp or z
+    vector<long long> locs; // the locations of the target pattern from kmp, z or find_all (64-bit for huge string_views)
     vector<int> occs; // the number of occurrences of each prefix
     vector<int> d1, d2; // number of odd and even palindromes centered at position i
 
     // Computes for each index, i, the length of the longest string that is 
     // both a prefix and a suffix of s[0...i]
     // Time: O(N)
-    void lps(string& s) {
-        pi.resize(s.size());
-        pi[0] = 0;
+    static void lps(string_view s, vector<int>& pi) {
+        pi.assign(s.size(), 0);
         for (int i = 1; i < (int) s.size(); i++) {
             // finds the lps at position i
             // consider the example abadfacabadfab and suppose we are at the final position
@@ -29,6 +33,7 @@ struct string_search {
             pi[i] = j;
         }
     }
+    void lps(string_view s) { lps(s, pi); }
 
     // KMP algorithm to find all the locations of string t in string s
     // Time: O(N+M)
@@ -40,6 +45,72 @@ struct string_search {
         for (int i = 2 * t.size(); i < (int) q.size(); i++) if (pi[i] == (int) t.size()) locs.push_back(i - 2 * t.size());
     }
 
+    // KMP search of t in s[from...] that appends the matches to locs, only the prefix function of t is stored
+    // (in a local array, the member pi is left alone)
+    void kmp_scan(string_view s, string_view t, size_t from) {
+        vector<int> pi;
+        lps(t, pi);
+        for (size_t i = from, j = 0; i < s.size(); i++) {
+            while (j > 0 && s[i] != t[j]) j = pi[j - 1];
+            if (s[i] == t[j]) j++;
+            if (j == t.size()) locs.push_back(i + 1 - j), j = pi[j - 1];
+        }
+    }
+
+    // KMP algorithm to find all the locations of string t in string s without building t + separator + s
+    // Time: O(N+M)
+    void kmp(string_view s, string_view t) {
+        locs.clear();
+        if (t.size()) kmp_scan(s, t, 0);
+    }
+
+    // Verifies the candidate p of find_all. Once the verifications have compared too many characters
+    // (t is periodic and matches almost everywhere) the rest of s is searched with kmp and false is returned
+    bool check(string_view s, string_view t, size_t p, size_t& work) {
+        work += t.size();
+        if (work > 8 * p + 4 * t.size() + 4096) {
+            kmp_scan(s, t, p);
+            return false;
+        }
+        if (memcmp(s.data() + p, t.data(), t.size()) == 0) locs.push_back(p);
+        return true;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // Compares 32 positions at once against the first and last characters of t, returns false if check gave up
+    __attribute__((target("avx2"))) bool find_avx2(string_view s, string_view t, size_t& p, size_t& work) {
+        size_t n = s.size(), m = t.size();
+        const __m256i first = _mm256_set1_epi8(t[0]), last = _mm256_set1_epi8(t[m - 1]);
+        for (; p + m + 31 <= n; p += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i*) (s.data() + p));
+            __m256i b = _mm256_loadu_si256((const __m256i*) (s.data() + p + m - 1));
+            unsigned mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+            for (; mask; mask &= mask - 1) if (!check(s, t, p + __builtin_ctz(mask), work)) return false;
+        }
+        return true;
+    }
+#endif
+
+    // Finds all the locations of string t in string s without copying either of them
+    // Only the positions where the first and last characters of t match are verified, they are found 32 at a time
+    // with AVX2 (when the cpu supports it) and with memchr otherwise. Periodic patterns fall back to kmp.
+    // Time: O(N+M), usually far fewer than N character comparisons
+    void find_all(string_view s, string_view t) {
+        locs.clear();
+        size_t n = s.size(), m = t.size(), p = 0, work = 0;
+        if (m == 0 || m > n) return;
+#if defined(__x86_64__) || defined(__i386__)
+        if (__builtin_cpu_supports("avx2") && !find_avx2(s, t, p, work)) return;
+#endif
+        const char* b = s.data();
+        for (; p + m <= n; p++) {
+            const char* c = (const char*) memchr(b + p, t[0], n - m + 1 - p);
+            if (!c) break;
+            p = c - b;
+            if (b[p + m - 1] == t[m - 1] && !check(s, t, p, work)) return;
+        }
+    }
+
     // Counts the number of occurrences of each prefix of s
     // Time: O(N)
     void get_occs(string& s) {
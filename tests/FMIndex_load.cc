@@ -0,0 +1,45 @@
+// Regression test for FMIndex::load on corrupted files.
+// g++ -std=c++17 -fsanitize=address,undefined tests/FMIndex_load.cc && ./a.out
+#include <bits/stdc++.h>
+using namespace std;
+#include "../atcoder/string.cc"
+#include "../string/FMIndex.cc"
+
+const string path = "/tmp/FMIndex_load_test.bin";
+
+vector<char> read_file() {
+    ifstream f(path, ios::binary);
+    return vector<char>(istreambuf_iterator<char>(f), {});
+}
+void write_file(const vector<char>& b) {
+    ofstream f(path, ios::binary);
+    f.write(b.data(), b.size());
+}
+// the file with the int64 at offset pos replaced by x
+bool load_with(const vector<char>& good, size_t pos, int64_t x) {
+    vector<char> b = good;
+    memcpy(b.data() + pos, &x, sizeof(x));
+    write_file(b);
+    FMIndex fm;
+    return fm.load(path);
+}
+
+int main() {
+    string s = "abracadabra_abracadabra";
+    FMIndex fm(s, atcoder::suffix_array(s), 4);
+    assert(fm.save(path));
+    FMIndex loaded;
+    assert(loaded.load(path) && loaded.locate("abra") == fm.locate("abra"));
+    vector<char> good = read_file();
+    size_t words = (s.size() + 1) / 64 + 1;
+    for (int l = 0; l < 8; l++) { // the zeros word of level l follows the header and the earlier levels
+        size_t pos = 40 + l * (8 + words * 8);
+        assert(!load_with(good, pos, 1LL << 40));
+        assert(!load_with(good, pos, fm.zeros[l] + 1));
+        assert(!load_with(good, pos, -1));
+    }
+    assert(!load_with(good, 8, 1LL << 62)); // n
+    assert(!load_with(good, 32, 1LL << 61)); // the number of samples
+    remove(path.c_str());
+    puts("ok");
+}
\ No newline at end of file